@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdio>
+
+#include "ecsa.h"
+
+using namespace ecsa;
+
+// number of entities and of frames
+constexpr int ENTITIES = 4096;
+constexpr int FRAMES = 2000;
+
+// components ids
+#define POSITION 0
+#define VELOCITY 1
+#define GFX 2
+
+// components
+struct Vector2 : Component
+{
+    float x, y;
+
+    Vector2(float x = 0, float y = 0) : x(x), y(y)
+    {
+
+    }
+};
+
+struct Gfx : Component
+{
+    int sprite [ 4 ] = { };
+};
+
+using PointerTable = EntityTable<ENTITIES, 8, 2>;
+using ChunkTable = ArchetypeTable<ENTITIES, 8, 2, 16>;
+
+// the movement system, which reads the components of each entity with get()
+template<typename Table>
+class Movement : public System<ENTITIES, ENTITIES, All<POSITION, VELOCITY, GFX>>
+{
+    Table & _table;
+
+    public:
+
+    Movement(Table & table) : _table(table)
+    {
+
+    }
+
+    void update() override
+    {
+        for (Entity e : subscribed())
+        {
+            Vector2 & p = _table.template get<Vector2, POSITION>(e);
+            Vector2 & v = _table.template get<Vector2, VELOCITY>(e);
+            Gfx & g = _table.template get<Gfx, GFX>(e);
+            p.x += v.x;
+            p.y += v.y;
+            g.sprite[0] = (int) p.x;
+        }
+    }
+};
+
+// the same movement, on the component arrays of each chunk
+void move_chunks(ChunkTable & table)
+{
+    table.chunks<POSITION, VELOCITY, GFX>([](ChunkTable::Chunk & chunk) {
+        Vector2 * p = chunk.column<Vector2, POSITION>();
+        Vector2 * v = chunk.column<Vector2, VELOCITY>();
+        Gfx * g = chunk.column<Gfx, GFX>();
+        for (int i = 0; i < chunk.size(); i++)
+        {
+            p[i].x += v[i].x;
+            p[i].y += v[i].y;
+            g[i].sprite[0] = (int) p[i].x;
+        }
+    });
+}
+
+template<typename Function>
+double measure(Function f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; i++)
+        f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / FRAMES;
+}
+
+int main()
+{
+    PointerTable * pointers = new PointerTable();
+    pointers->add<0>(new Movement<PointerTable>(*pointers));
+    for (int i = 0; i < ENTITIES; i++)
+    {
+        Entity e = pointers->create();
+        pointers->add<POSITION>(e, new Vector2(i, i));
+        pointers->add<VELOCITY>(e, new Vector2(1, 1));
+        pointers->add<GFX>(e, new Gfx());
+    }
+
+    ChunkTable * chunks = new ChunkTable();
+    chunks->add<0>(new Movement<ChunkTable>(*chunks));
+    for (int i = 0; i < ENTITIES; i++)
+    {
+        Entity e = chunks->create();
+        chunks->emplace<Vector2, POSITION>(e, i, i);
+        chunks->emplace<Vector2, VELOCITY>(e, 1, 1);
+        chunks->emplace<Gfx, GFX>(e);
+    }
+
+    printf("EntityTable, get():       %.1f us/frame\n", measure([pointers]() { pointers->update(); }));
+    printf("ArchetypeTable, get():    %.1f us/frame\n", measure([chunks]() { chunks->update(); }));
+    printf("ArchetypeTable, chunks(): %.1f us/frame\n", measure([chunks]() { move_chunks(*chunks); }));
+
+    delete pointers;
+    delete chunks;
+    return 0;
+}
\ No newline at end of file
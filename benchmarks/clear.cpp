@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstdio>
+
+#include "ecsa.h"
+
+using namespace ecsa;
+
+// number of runs of each measure (the best one is kept)
+constexpr int RUNS = 5;
+
+// components
+struct Counter : Component
+{
+    int x = 0;
+};
+
+// a system subscribing every entity with a Counter
+template<int Entities>
+class Counting : public System<Entities, Entities, All<0>>
+{
+
+};
+
+// clear() on a full EntityTable with 4 systems, which unsubscribes every entity from every system
+template<int Entities>
+void measure()
+{
+    using Table = EntityTable<Entities, 2, 4>;
+    Table * table = new Table();
+    table->template add<0>(new Counting<Entities>());
+    table->template add<1>(new Counting<Entities>());
+    table->template add<2>(new Counting<Entities>());
+    table->template add<3>(new Counting<Entities>());
+
+    double best = 0;
+    for (int r = 0; r < RUNS; r++)
+    {
+        for (int i = 0; i < Entities; i++)
+        {
+            Entity e = table->create();
+            table->template emplace<Counter, 0>(e);
+        }
+        auto start = std::chrono::steady_clock::now();
+        table->clear();
+        auto end = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(end - start).count();
+        if (r == 0 || us < best)
+            best = us;
+    }
+    printf("%5d entities: clear() %.1f us\n", Entities, best);
+    delete table;
+}
+
+int main()
+{
+    measure<128>();
+    measure<1024>();
+    measure<16384>();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdio>
+
+#include "ecsa.h"
+
+using namespace ecsa;
+
+// number of runs of each measure (the best one is kept), and of scans in each run
+constexpr int RUNS = 20;
+constexpr int SCANS = 100;
+
+// components
+struct Counter : Component
+{
+    int x = 0;
+};
+
+template<int Entities>
+using Table = EntityTable<Entities, 2, 1>;
+
+// the predicate of the scans, which reads the component of the entity and keeps one entity in 8
+template<int Entities>
+bool predicate(Table<Entities> & table, Entity e)
+{
+    return table.template get<Counter, 0>(e).x == 0;
+}
+
+// the best time of a scan, in microseconds
+template<typename Scan>
+double best(Scan scan, int & result)
+{
+    double best = 0;
+    for (int r = 0; r < RUNS; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < SCANS; i++)
+            result += scan();
+        auto end = std::chrono::steady_clock::now();
+        double us = std::chrono::duration<double, std::micro>(end - start).count() / SCANS;
+        if (r == 0 || us < best)
+            best = us;
+    }
+    return best;
+}
+
+// query() with a function, from().where().count() and a loop over from() on a table with a percentage of live entities
+template<int Entities>
+void measure(int percent)
+{
+    Table<Entities> * table = new Table<Entities>();
+    for (int i = 0; i < Entities; i++)
+    {
+        Entity e = table->create();
+        table->template emplace<Counter, 0>(e).x = e & 7;
+    }
+    for (Entity e = 0; e < Entities; e++)
+    {
+        if ((e * 37) % 100 >= percent)
+            table->destroy(e);
+    }
+
+    int result = 0;
+    double query = best([table]() { return table->template query<Entities>(&predicate<Entities>).size(); }, result);
+    double count = best([table]() { return table->from().where(&predicate<Entities>).count(); }, result);
+    double loop = best([table]() {
+        int sum = 0;
+        for (Entity e : table->from())
+            sum += table->template get<Counter, 0>(e).x;
+        return sum & 1;
+    }, result);
+    printf("%5d entities, %3d%% live: query %.1f us, from().count %.1f us, for (from()) %.1f us (%d)\n",
+        Entities, percent, query, count, loop, result & 1);
+    delete table;
+}
+
+int main()
+{
+    measure<1024>(5);
+    measure<1024>(50);
+    measure<1024>(100);
+    measure<65536>(5);
+    measure<65536>(50);
+    measure<65536>(100);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#ifndef BN_LOG_H
+#define BN_LOG_H
+
+// Empty stand-in for the butano header included by ECSA, to build the benchmarks on the host.
+
+#endif
\ No newline at end of file
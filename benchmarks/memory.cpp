@@ -0,0 +1,66 @@
+#include <cstdio>
+
+#include "ecsa.h"
+
+using namespace ecsa;
+
+// number of 32-bit words needed for n bits
+constexpr int W(int n)
+{
+    return (n + 31) / 32;
+}
+
+// size of an Id stored as EntityIndex<n>
+constexpr int I(int n)
+{
+    return n <= 256 ? 1 : n <= 65536 ? 2 : 4;
+}
+
+// n rounded up to a multiple of 4
+constexpr int align4(int n)
+{
+    return (n + 3) / 4 * 4;
+}
+
+// the size of an EntityTable<E, C, S> with 4-byte pointers, row by row as in the README
+constexpr int table_bytes(int E, int C, int S)
+{
+    return 4 * W(C) * E                                 // signatures of the entities
+        + 4 * E                                         // handle generations
+        + 4 * W(E) + 4 * W(W(E)) + 28                   // deferred changes
+        + 4 * W(E) * C + 4                              // page pointers of the columns
+        + 4 * W(E) * C + 4                              // page pointers of the change ticks
+        + 40 * C + 4                                    // pools, IWRAM and sparse column pointers, indexes, dependencies
+        + 12 * S + 16 * W(C) * S + 4 * C * S            // systems
+        + 8 * W(E) + 8 * W(W(E))                        // entity masks
+        + 28;                                           // counters, flags and executor
+}
+
+// the size of a System<E, N> with 4-byte pointers, as in the README
+constexpr int system_bytes(int E, int N)
+{
+    return align4(I(E) * N) + align4(I(N) * E) + 4 * W(E) + 4 * W(W(E)) + 60;
+}
+
+// the README formulas are given for the GBA: build with -m32 (or for the GBA) to check them
+constexpr bool GBA = sizeof(void *) == 4;
+
+static_assert(!GBA || sizeof(EntityTable<256, 32, 8>) == table_bytes(256, 32, 8), "EntityTable<256, 32, 8>");
+static_assert(!GBA || sizeof(EntityTable<256, 32, 8>) < 8 * 1024, "EntityTable<256, 32, 8> takes 8 kbytes or more");
+static_assert(!GBA || sizeof(EntityTable<128, 8, 7>) == table_bytes(128, 8, 7), "EntityTable<128, 8, 7>");
+static_assert(!GBA || sizeof(EntityTable<1024, 40, 20>) == table_bytes(1024, 40, 20), "EntityTable<1024, 40, 20>");
+static_assert(!GBA || sizeof(System<128, 32>) == system_bytes(128, 32), "System<128, 32>");
+static_assert(!GBA || sizeof(System<256, 256>) == system_bytes(256, 256), "System<256, 256>");
+static_assert(!GBA || sizeof(System<1024, 64>) == system_bytes(1024, 64), "System<1024, 64>");
+static_assert(!GBA || sizeof(System<1000, 30>) == system_bytes(1000, 30), "System<1000, 30>");
+
+int main()
+{
+    printf("EntityTable<256, 32, 8>: %d bytes (%d on the GBA)\n", int(sizeof(EntityTable<256, 32, 8>)), table_bytes(256, 32, 8));
+    printf("EntityTable<128, 8, 7>: %d bytes (%d on the GBA)\n", int(sizeof(EntityTable<128, 8, 7>)), table_bytes(128, 8, 7));
+    printf("EntityTable<1024, 40, 20>: %d bytes (%d on the GBA)\n", int(sizeof(EntityTable<1024, 40, 20>)), table_bytes(1024, 40, 20));
+    printf("System<128, 32>: %d bytes (%d on the GBA)\n", int(sizeof(System<128, 32>)), system_bytes(128, 32));
+    printf("System<256, 256>: %d bytes (%d on the GBA)\n", int(sizeof(System<256, 256>)), system_bytes(256, 256));
+    printf("System<1024, 64>: %d bytes (%d on the GBA)\n", int(sizeof(System<1024, 64>)), system_bytes(1024, 64));
+    return 0;
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef ECSA_H
 #define ECSA_H
 
+#include <cstdint>
+#include <type_traits>
+
 
 namespace ecsa
 {
@@ -12,6 +15,50 @@ namespace ecsa
     using Entity = int;
 
 
+    /**
+     * @brief The narrowest unsigned type that can store a number from 0 to `Count - 1`
+     * (`uint8_t` up to 256, `uint16_t` up to 65536, `uint32_t` otherwise).
+     * Used to store entity Ids and positions compactly: entity Ids are still passed around as `Entity`.
+     * 
+     * @tparam Count The number of values to represent (for example, the maximum number of entities of a table).
+     */
+    template<int Count>
+    using EntityIndex = std::conditional_t<Count <= 256, std::uint8_t,
+        std::conditional_t<Count <= 65536, std::uint16_t, std::uint32_t>>;
+
+
+    /**
+     * @brief A reference to an entity that can be checked for staleness: it packs the Id of the entity
+     * together with the generation of its slot, which changes every time the entity in that slot is destroyed.
+     * 
+     */
+    struct Handle
+    {
+        Entity entity;
+        unsigned int generation;
+
+        constexpr Handle() : entity(-1), generation(0)
+        {
+
+        }
+
+        constexpr Handle(Entity entity, unsigned int generation) : entity(entity), generation(generation)
+        {
+
+        }
+
+        [[nodiscard]] constexpr bool operator==(const Handle & other) const
+        {
+            return entity == other.entity && generation == other.generation;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const Handle & other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+
     /**
      * @brief Base struct for every component.
      * 
@@ -40,11 +87,29 @@ namespace ecsa
      * Does not preserve the order of elements when an element is erased.
      * 
      * @tparam MaxSize The maximum capacity of the bag.
+     * @tparam Index The type the IDs are stored as (`Entity` by default, or a narrower `EntityIndex`).
      */
-    template<int MaxSize>
+    template<int MaxSize, typename Index = Entity>
     class EntityBag;
 
 
+    /**
+     * @brief A non-owning, read-only view over a sequence of entity IDs (for example, the entities subscribed to a system).
+     * It does not copy the IDs, so it is only valid until the underlying sequence changes.
+     * 
+     * @tparam Index The type the IDs are stored as.
+     */
+    template<typename Index>
+    class BasicEntityView;
+
+
+    /**
+     * @brief A view over a sequence of entity IDs stored as `Entity`.
+     * 
+     */
+    using EntityView = BasicEntityView<Entity>;
+
+
     /**
      * @brief A bitmask-like data structure used for keeping track of entities.
      * 
@@ -54,6 +119,70 @@ namespace ecsa
     class EntityMask;
 
 
+    /**
+     * @brief A slab allocator for objects of a fixed size. Freed slots are recycled
+     * by later allocations instead of going back to the heap.
+     * 
+     */
+    class Pool;
+
+
+    /**
+     * @brief A sparse set of components: components are stored in a packed (dense) array,
+     * and a sparse array maps each entity Id to the position of its component.
+     * 
+     * @tparam Type The data type of the components.
+     * @tparam Entities The maximum number of entities of the table owning the set.
+     * @tparam MaxSize The maximum number of components the set can hold.
+     */
+    template<typename Type, int Entities, int MaxSize>
+    class SparseSet;
+
+
+    /**
+     * @brief A bitmask of component Ids, describing which components an entity owns.
+     * 
+     * @tparam Components The maximum number of components.
+     */
+    template<int Components>
+    class Signature;
+
+
+    /**
+     * @brief A lazy query on the entities of a table: filters added with `where` are only evaluated
+     * when the query is iterated, all together in a single pass.
+     * 
+     * @tparam Table The type of the table.
+     * @tparam Source The entities the query runs on (`ViewSource`, `TableSource`, or the result of an index lookup).
+     * @tparam Filters The types of the filters.
+     */
+    template<typename Table, typename Source, typename... Filters>
+    class Query;
+
+
+    /**
+     * @brief Records structural changes to a table (creating and destroying entities, adding and removing components),
+     * so that they can be applied later in a single batch, when no system is iterating on the entities.
+     * 
+     * @tparam Table The type of the table.
+     * @tparam Entities The maximum number of entities of the table.
+     */
+    template<typename Table, int Entities>
+    class CommandBuffer;
+
+
+    /**
+     * @brief Base class for entity tables: holds the systems associated to a table and implements queries.
+     * 
+     * @tparam Table The actual table type.
+     * @tparam Entities The maximum number of entities that can be allocated.
+     * @tparam Components The maximum number of components each entity can have.
+     * @tparam Systems The maximum number of systems that can be associated to the table.
+     */
+    template<typename Table, int Entities, int Components, int Systems>
+    class BasicTable;
+
+
     /**
      * @brief The main data structure of ECSA, allows to organize entities (game objects) and their components.
      * Each table can also have some systems associated, which are used to process the components of each entity.
@@ -65,6 +194,52 @@ namespace ecsa
      */
     template<int Entities, int Components, int Systems>
     class EntityTable;
+
+
+    /**
+     * @brief An entity table which stores together the components of entities that own the same set of components
+     * (archetype), in fixed-size chunks where each component has its own contiguous array.
+     * It has the same interface as `EntityTable`, but components are stored by value.
+     * 
+     * @tparam Entities The maximum number of entities that can be allocated.
+     * @tparam Components The maximum number of components each entity can have.
+     * @tparam Systems The maximum number of systems that can be associated to the table.
+     * @tparam Archetypes The maximum number of archetypes (distinct sets of components) in the table.
+     */
+    template<int Entities, int Components, int Systems, int Archetypes>
+    class ArchetypeTable;
+
+
+    /**
+     * @brief A compile-time list of component types. The Id of each component is its index in the list.
+     * 
+     * @tparam Types The types of the components.
+     */
+    template<typename... Types>
+    struct ComponentList;
+
+
+    /**
+     * @brief A column of components of a single type, stored by value and indexed by entity Id.
+     * 
+     * @tparam Type The data type of the components.
+     * @tparam Entities The maximum number of entities of the table owning the column.
+     */
+    template<typename Type, int Entities>
+    class TypedColumn;
+
+
+    /**
+     * @brief An entity table whose components are declared at compile time through a `ComponentList`.
+     * It has the same interface as `EntityTable`, but each component Id maps to its type at compile time:
+     * components are stored by value in typed columns, and they do not need to inherit from `Component`.
+     * 
+     * @tparam Entities The maximum number of entities that can be allocated.
+     * @tparam Components A `ComponentList` with the types of the components.
+     * @tparam Systems The maximum number of systems that can be associated to the table.
+     */
+    template<int Entities, typename Components, int Systems>
+    class TypedEntityTable;
     
 
     /**
@@ -74,22 +249,185 @@ namespace ecsa
     class ISystem;
 
 
+    /**
+     * @brief Declares the components an entity must own to be processed by a system.
+     * 
+     * @tparam Ids The Ids of the components.
+     */
+    template<int... Ids>
+    struct All;
+
+
+    /**
+     * @brief Declares the components an entity must not own to be processed by a system.
+     * 
+     * @tparam Ids The Ids of the components.
+     */
+    template<int... Ids>
+    struct None;
+
+
+    /**
+     * @brief Declares the components a system reads in its `update` function.
+     * 
+     * @tparam Ids The Ids of the components.
+     */
+    template<int... Ids>
+    struct Reads;
+
+
+    /**
+     * @brief Declares the components a system writes in its `update` function.
+     * 
+     * @tparam Ids The Ids of the components.
+     */
+    template<int... Ids>
+    struct Writes;
+
+
+    /**
+     * @brief Runs a batch of tasks, possibly on several threads at once (for example, the systems of a table that
+     * do not conflict with each other). ECSA does not create threads itself: on platforms that support them,
+     * `ThreadPool` (in `ecsa_thread_pool.h`, not included by default) runs the tasks on a pool of worker threads.
+     * 
+     */
+    class Executor;
+
+
     /**
      * @brief A system processes entities that staisfy a certain condtion (like owning (a) certain component(s)).
      * 
      * @tparam TableEntities The maximum number of entities alllowed for the EntityTable owning the system.
      * @tparam SystemEntities The maximum number of entities the system is expected to process.
+     * @tparam Required An `All` with the components an entity must own to be subscribed automatically.
+     * @tparam Excluded A `None` with the components an entity must not own to be subscribed automatically.
      */
-    template<int TableEntities, int SystemEntities>
+    template<int TableEntities, int SystemEntities, typename Required = All<>, typename Excluded = None<>>
     class System;
 
+
+    /**
+     * @brief A persistent query: a system without `update`, whose subscribed entities are the results of the query.
+     * They are kept up to date by the table as components are added and removed, like for any other system,
+     * so reading them costs nothing more than iterating on them. Entities must own the declared components
+     * and satisfy `select`, which can depend on a parameter: changing it re-evaluates the results.
+     * 
+     * @tparam TableEntities The maximum number of entities alllowed for the EntityTable owning the query.
+     * @tparam Size The maximum number of entities the query is expected to return.
+     * @tparam Required An `All` with the components an entity must own to be returned by the query.
+     * @tparam Excluded A `None` with the components an entity must not own to be returned by the query.
+     * @tparam ParamType The type of the parameter of the query (`void` if the query has no parameter).
+     */
+    template<int TableEntities, int Size, typename Required = All<>, typename Excluded = None<>, typename ParamType = void>
+    class CachedQuery;
+
+
+    /**
+     * @brief Base class for indexes on a field of a component.
+     * 
+     */
+    class IIndex;
+
+
+    template<typename Member>
+    struct FieldType;
+
+
+    template<typename Key>
+    struct IndexHash;
+
+
+    /**
+     * @brief An index on a field of a component, which keeps the entities sorted by the value of the field.
+     * Answers equality and range lookups in O(log n + k), and returns the results as an `EntityView`.
+     * 
+     * @tparam Table The type of the table.
+     * @tparam Type The type of the component.
+     * @tparam Id The Id of the component.
+     * @tparam Field A pointer to the indexed field (e.g. `&Vector2::x`). Its type must support `<`.
+     */
+    template<typename Table, typename Type, int Id, auto Field>
+    class OrderedIndex;
+
+
+    /**
+     * @brief An index on a field of a component, which keeps the entities in buckets by the hash of the field.
+     * Answers equality lookups in O(1 + k) on average.
+     * 
+     * @tparam Table The type of the table.
+     * @tparam Type The type of the component.
+     * @tparam Id The Id of the component.
+     * @tparam Field A pointer to the indexed field (e.g. `&Color::color`). Its type must support `==`.
+     * @tparam Buckets The number of buckets.
+     * @tparam Hash The hash function (`IndexHash` converts the field to `unsigned int`).
+     */
+    template<typename Table, typename Type, int Id, auto Field, int Buckets = 32,
+        typename Hash = IndexHash<typename FieldType<decltype(Field)>::type>>
+    class HashIndex;
+
+
+    template<typename Key>
+    struct GridCoordinate;
+
+
+    /**
+     * @brief A uniform grid partitioning the entities of a table by their position, rebuilt in bulk (usually once per frame).
+     * Answers box and radius queries, and enumerates the pairs of close entities, by only checking the neighbouring cells.
+     * 
+     * @tparam Table The type of the table.
+     * @tparam Type The type of the position component.
+     * @tparam Id The Id of the position component.
+     * @tparam X A pointer to the x coordinate of the position (e.g. `&Vector2::x`).
+     * @tparam Y A pointer to the y coordinate of the position (e.g. `&Vector2::y`).
+     * @tparam Columns The number of columns of the grid.
+     * @tparam Rows The number of rows of the grid.
+     */
+    template<typename Table, typename Type, int Id, auto X, auto Y, int Columns, int Rows>
+    class SpatialGrid;
+
+
+    /**
+     * @brief Declares a component of a prefab.
+     * 
+     * @tparam Type The type of the component.
+     * @tparam Id The Id of the component.
+     */
+    template<typename Type, int Id>
+    struct With;
+
+
+    /**
+     * @brief A template for entities: a set of components with their initial values, copied to each entity created with the prefab.
+     * Many entities can be created at once, and subscribed to the systems they belong to in a single step.
+     * 
+     * @tparam Table The type of the table.
+     * @tparam Components A `With` for each component.
+     */
+    template<typename Table, typename... Components>
+    class Prefab;
+
 }
 
 #include "ecsa_array.h"
 #include "ecsa_entity_bag.h"
+#include "ecsa_entity_view.h"
 #include "ecsa_entity_mask.h"
+#include "ecsa_pool.h"
+#include "ecsa_sparse_set.h"
+#include "ecsa_signature.h"
+#include "ecsa_executor.h"
 #include "ecsa_isystem.h"
 #include "ecsa_system.h"
+#include "ecsa_cached_query.h"
+#include "ecsa_index.h"
+#include "ecsa_spatial_grid.h"
+#include "ecsa_prefab.h"
+#include "ecsa_command_buffer.h"
+#include "ecsa_query.h"
+#include "ecsa_basic_table.h"
 #include "ecsa_entity_table.h"
+#include "ecsa_archetype_table.h"
+#include "ecsa_typed_column.h"
+#include "ecsa_typed_entity_table.h"
 
 #endif
\ No newline at end of file
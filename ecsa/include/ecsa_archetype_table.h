@@ -0,0 +1,696 @@
+#ifndef ECSA_ARCHETYPE_TABLE_H
+#define ECSA_ARCHETYPE_TABLE_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "ecsa.h"
+
+namespace ecsa
+{
+    template<int Entities, int Components, int Systems, int Archetypes>
+    class ArchetypeTable : public BasicTable<ArchetypeTable<Entities, Components, Systems, Archetypes>, Entities, Components, Systems>
+    {
+        using Base = BasicTable<ArchetypeTable<Entities, Components, Systems, Archetypes>, Entities, Components, Systems>;
+
+        public:
+
+
+        /**
+         * @brief Number of entities stored in each chunk.
+         * 
+         */
+        static constexpr int ChunkEntities = 32;
+
+
+        /**
+         * @brief A block of memory holding up to `ChunkEntities` entities of the same archetype.
+         * Each component of the archetype is stored in its own contiguous array inside the chunk.
+         * 
+         */
+        class Chunk
+        {
+            friend class ArchetypeTable;
+
+
+            /**
+             * @brief Byte offset of each component array in the chunk (-1 if the archetype does not have the component).
+             * 
+             */
+            Array<int, Components> * _offsets;
+
+
+            /**
+             * @brief The component arrays.
+             * 
+             */
+            unsigned char * _data;
+
+
+            /**
+             * @brief The number of entities in the chunk.
+             * 
+             */
+            int _size;
+
+
+            /**
+             * @brief The Ids of the entities in the chunk.
+             * 
+             */
+            EntityIndex<Entities> _entities [ ChunkEntities ];
+
+
+            public:
+
+
+            /**
+             * @brief Tells the number of entities in the chunk.
+             * 
+             * @return int
+             */
+            [[nodiscard]] int size()
+            {
+                return _size;
+            }
+
+
+            /**
+             * @brief Tells if the entities in the chunk have a certain component.
+             * 
+             * @tparam Id The Id of the component.
+             * @return true
+             * @return false
+             */
+            template<int Id>
+            [[nodiscard]] bool has()
+            {
+                return (*_offsets)[Id] >= 0;
+            }
+
+
+            /**
+             * @brief Returns the array of components with a certain Id.
+             * The component at index `i` belongs to the `i`-th entity of the chunk.
+             * 
+             * @tparam Type The type of the component.
+             * @tparam Id The Id of the component.
+             * @return Type*
+             */
+            template<typename Type, int Id>
+            [[nodiscard]] Type * column()
+            {
+                assert(has<Id>() && "ECSA ERROR: component not found!");
+                return (Type *) (_data + (*_offsets)[Id]);
+            }
+
+
+            /**
+             * @brief Beginning of the entity Ids of the chunk (iterator).
+             * 
+             * @return EntityIndex<Entities>*
+             */
+            [[nodiscard]] EntityIndex<Entities> * begin()
+            {
+                return _entities;
+            }
+
+
+            /**
+             * @brief End of the entity Ids of the chunk (iterator).
+             * 
+             * @return EntityIndex<Entities>*
+             */
+            [[nodiscard]] EntityIndex<Entities> * end()
+            {
+                return _entities + _size;
+            }
+        };
+
+
+        private:
+
+
+        /**
+         * @brief Maximum number of chunks per archetype.
+         * 
+         */
+        static constexpr int MaxChunks = (Entities - 1) / ChunkEntities + 1;
+
+
+        /**
+         * @brief Type-erased information about the type stored in a column.
+         * 
+         */
+        struct Column
+        {
+            int size;
+            int align;
+            void (* move) (void * dst, void * src);
+            void (* destroy) (void * c);
+        };
+
+
+        /**
+         * @brief A set of entities that own exactly the same components.
+         * 
+         */
+        struct Archetype
+        {
+            Signature<Components> signature;
+            Array<int, Components> offsets;
+            Array<int, Components> next;
+            Array<int, Components> previous;
+            Array<Chunk *, MaxChunks> chunks;
+            int chunk_bytes;
+            int chunk_count;
+            int size;
+        };
+
+
+        EntityMask<Entities> _entities;
+        Array<EntityIndex<Archetypes>, Entities> _archetype_of;
+        Array<EntityIndex<Entities>, Entities> _row_of;
+
+        Array<Column, Components> _columns;
+        Array<Archetype *, Archetypes> _archetypes;
+        int _archetype_count;
+
+
+        /**
+         * @brief Move-construct a component into uninitialized memory, and destroy the original.
+         * 
+         */
+        template<typename Type>
+        static void move_component(void * dst, void * src)
+        {
+            new (dst) Type(std::move(*((Type *) src)));
+            ((Type *) src)->~Type();
+        }
+
+
+        /**
+         * @brief Destroy a component, without releasing its memory.
+         * 
+         */
+        template<typename Type>
+        static void destroy_component(void * c)
+        {
+            ((Type *) c)->~Type();
+        }
+
+
+        /**
+         * @brief Create a new archetype and compute the layout of its chunks.
+         * 
+         * @param signature The components owned by the entities of the archetype.
+         * @return int The index of the archetype.
+         */
+        int create_archetype(Signature<Components> & signature)
+        {
+            assert(_archetype_count < Archetypes && "ECSA ERROR: too many archetypes!");
+            Archetype * a = new Archetype();
+            a->signature = signature;
+            a->chunk_bytes = 0;
+            a->chunk_count = 0;
+            a->size = 0;
+            for (int c = 0; c < Components; c++)
+            {
+                a->next[c] = -1;
+                a->previous[c] = -1;
+                a->offsets[c] = -1;
+                if (!signature.contains(c))
+                    continue;
+                int align = _columns[c].align;
+                a->chunk_bytes = (a->chunk_bytes + align - 1) / align * align;
+                a->offsets[c] = a->chunk_bytes;
+                a->chunk_bytes += _columns[c].size * ChunkEntities;
+            }
+            _archetypes[_archetype_count] = a;
+            return _archetype_count++;
+        }
+
+
+        /**
+         * @brief Find (or create) the archetype with a certain signature.
+         * 
+         * @param signature The components owned by the entities of the archetype.
+         * @return int The index of the archetype.
+         */
+        int find_archetype(Signature<Components> & signature)
+        {
+            for (int i = 0; i < _archetype_count; i++)
+            {
+                if (_archetypes[i]->signature == signature)
+                    return i;
+            }
+            return create_archetype(signature);
+        }
+
+
+        /**
+         * @brief Find (or create) the archetype obtained by adding a component to another archetype.
+         * 
+         * @param from The index of the starting archetype.
+         * @param c The Id of the component to add.
+         * @return int The index of the resulting archetype.
+         */
+        int next_archetype(int from, int c)
+        {
+            if (_archetypes[from]->next[c] >= 0)
+                return _archetypes[from]->next[c];
+
+            Signature<Components> signature = _archetypes[from]->signature;
+            signature.add(c);
+            int to = find_archetype(signature);
+            _archetypes[from]->next[c] = to;
+            _archetypes[to]->previous[c] = from;
+            return to;
+        }
+
+
+        /**
+         * @brief Find (or create) the archetype obtained by removing a component from another archetype.
+         * 
+         * @param from The index of the starting archetype.
+         * @param c The Id of the component to remove.
+         * @return int The index of the resulting archetype.
+         */
+        int previous_archetype(int from, int c)
+        {
+            if (_archetypes[from]->previous[c] >= 0)
+                return _archetypes[from]->previous[c];
+
+            Signature<Components> signature = _archetypes[from]->signature;
+            signature.destroy(c);
+            int to = find_archetype(signature);
+            _archetypes[from]->previous[c] = to;
+            _archetypes[to]->next[c] = from;
+            return to;
+        }
+
+
+        /**
+         * @brief Move an entity to another archetype. The components that the two archetypes
+         * have in common are moved, the ones the new archetype does not have are destroyed.
+         * 
+         * @param e The Id of the entity.
+         * @param to The index of the new archetype.
+         * @return int The row of the entity in the new archetype.
+         */
+        int move(Entity e, int to)
+        {
+            int from = _archetype_of[e];
+            int row = _row_of[e];
+            int new_row = push(to, e);
+            for (int c = 0; c < Components; c++)
+            {
+                if (_archetypes[from]->offsets[c] < 0)
+                    continue;
+                if (_archetypes[to]->offsets[c] >= 0)
+                    _columns[c].move(slot(to, new_row, c), slot(from, row, c));
+                else
+                    _columns[c].destroy(slot(from, row, c));
+            }
+            pop(from, row);
+            return new_row;
+        }
+
+
+        /**
+         * @brief Returns the address of the component of the entity stored at a certain row of an archetype.
+         * 
+         */
+        [[nodiscard]] void * slot(int a, int row, int c)
+        {
+            Archetype & archetype = *(_archetypes[a]);
+            Chunk * chunk = archetype.chunks[row / ChunkEntities];
+            return chunk->_data + archetype.offsets[c] + (row % ChunkEntities) * _columns[c].size;
+        }
+
+
+        /**
+         * @brief Append an entity to an archetype, allocating a new chunk if needed.
+         * Its components are left uninitialized.
+         * 
+         * @return int The row of the entity in the archetype.
+         */
+        int push(int a, Entity e)
+        {
+            Archetype & archetype = *(_archetypes[a]);
+            int row = archetype.size;
+            int i = row / ChunkEntities;
+            if (i == archetype.chunk_count)
+            {
+                Chunk * chunk = new Chunk();
+                chunk->_offsets = &archetype.offsets;
+                chunk->_data = archetype.chunk_bytes > 0 ? new unsigned char[archetype.chunk_bytes] : nullptr;
+                chunk->_size = 0;
+                archetype.chunks[i] = chunk;
+                archetype.chunk_count++;
+            }
+            Chunk * chunk = archetype.chunks[i];
+            chunk->_entities[row % ChunkEntities] = e;
+            chunk->_size++;
+            archetype.size++;
+            _archetype_of[e] = a;
+            _row_of[e] = row;
+            return row;
+        }
+
+
+        /**
+         * @brief Remove a row from an archetype, whose components have already been moved or destroyed.
+         * The last row of the archetype is moved into the freed one.
+         * 
+         */
+        void pop(int a, int row)
+        {
+            Archetype & archetype = *(_archetypes[a]);
+            int last = archetype.size - 1;
+            if (row != last)
+            {
+                for (int c = 0; c < Components; c++)
+                {
+                    if (archetype.offsets[c] >= 0)
+                        _columns[c].move(slot(a, row, c), slot(a, last, c));
+                }
+                Entity moved = archetype.chunks[last / ChunkEntities]->_entities[last % ChunkEntities];
+                archetype.chunks[row / ChunkEntities]->_entities[row % ChunkEntities] = moved;
+                _row_of[moved] = row;
+            }
+            archetype.chunks[last / ChunkEntities]->_size--;
+            archetype.size--;
+        }
+
+
+        public:
+
+        using Base::add;
+        using Base::get;
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        ArchetypeTable() : _archetype_of(0), _archetypes(nullptr), _archetype_count(0)
+        {
+            for (int c = 0; c < Components; c++)
+                _columns[c] = { 0, 0, nullptr, nullptr };
+            Signature<Components> empty;
+            create_archetype(empty);
+        }
+
+
+        /**
+         * @brief Create a new entity and return its Id.
+         * 
+         * @return Entity The Id of the entity, or -1 if the table is full.
+         */
+        [[nodiscard]] Entity create()
+        {
+            Entity e = _entities.create();
+            if (e < 0)
+                return -1;
+            push(0, e);
+            return e;
+        }
+
+
+        /**
+         * @brief Create a number of new entities, with contiguous Ids if possible.
+         * If the table is full, the bag only holds the entities that could be created.
+         * 
+         * @tparam Size The maximum size of the returned entity bag.
+         * @param n The number of entities.
+         * @return EntityBag<Size, EntityIndex<Entities>> The Ids of the new entities.
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, EntityIndex<Entities>> create(int n)
+        {
+            EntityBag<Size, EntityIndex<Entities>> entities;
+            _entities.create(n, entities);
+            for (Entity e : entities)
+                push(0, e);
+            return entities;
+        }
+
+
+        /**
+         * @brief Remove an entity from the table,
+         * and unsubscribe it from all the relevant systems.
+         * The entity is moved back to the empty archetype, so that it has no components until it is reused.
+         * 
+         * @param e The Id of the entity.
+         */
+        void destroy(Entity e)
+        {
+            int a = _archetype_of[e];
+            int row = _row_of[e];
+            for (int c = 0; c < Components; c++)
+            {
+                if (_archetypes[a]->offsets[c] >= 0)
+                    _columns[c].destroy(slot(a, row, c));
+            }
+            pop(a, row);
+            _archetype_of[e] = 0;
+            this->retire(e);
+            _entities.destroy(e);
+        }
+
+
+        /**
+         * @brief Destroy all the entities in the table.
+         * The components of each archetype are destroyed one column at a time, and the archetypes are emptied
+         * without moving any row (their chunks are kept for the next entities).
+         * 
+         */
+        void clear()
+        {
+            this->reset(_entities);
+            _entities.for_each([this](Entity e) { _archetype_of[e] = 0; });
+            for (int a = 0; a < _archetype_count; a++)
+            {
+                Archetype & archetype = *(_archetypes[a]);
+                if (archetype.size == 0)
+                    continue;
+                for (int c = 0; c < Components; c++)
+                {
+                    if (archetype.offsets[c] < 0)
+                        continue;
+                    for (int row = 0; row < archetype.size; row++)
+                        _columns[c].destroy(slot(a, row, c));
+                }
+                for (int i = 0; i < archetype.chunk_count; i++)
+                    archetype.chunks[i]->_size = 0;
+                archetype.size = 0;
+            }
+            _entities.clear();
+        }
+
+
+        /**
+         * @brief Tells if the table contains a certain entity.
+         * 
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains(Entity e)
+        {
+            return _entities.contains(e);
+        }
+
+
+        /**
+         * @brief Returns the mask of the entities in the table, which can be iterated
+         * to visit them in increasing order without checking the empty slots.
+         * 
+         * @return const EntityMask<Entities>& 
+         */
+        [[nodiscard]] const EntityMask<Entities> & entities()
+        {
+            return _entities;
+        }
+
+
+        /**
+         * @brief Construct a component of an entity in place.
+         * The entity (and all its components) is moved to the archetype that includes the new component.
+         * All the components with the same Id must have the same type.
+         * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @tparam Args The types of the arguments passed to the component's constructor.
+         * @param e The Id of the entity.
+         * @param args The arguments passed to the component's constructor.
+         * @return Type&
+         */
+        template<typename Type, int Id, typename... Args>
+        Type & emplace(Entity e, Args &&... args)
+        {
+            assert(!has<Id>(e) && "ECSA ERROR: component already exists!");
+            if (_columns[Id].size == 0)
+                _columns[Id] = { (int) sizeof(Type), (int) alignof(Type), &move_component<Type>, &destroy_component<Type> };
+            assert(_columns[Id].size == (int) sizeof(Type) && "ECSA ERROR: all the components with the same Id must have the same type!");
+            assert(alignof(Type) <= alignof(std::max_align_t) && "ECSA ERROR: over-aligned types are not supported!");
+
+            int to = next_archetype(_archetype_of[e], Id);
+            int new_row = move(e, to);
+            Type * c = new (slot(to, new_row, Id)) Type(std::forward<Args>(args)...);
+            this->refresh(e, Id);
+            return *c;
+        }
+
+
+        /**
+         * @brief Add a component to an entity. (will be copied)
+         * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @param c The component.
+         */
+        template<typename Type, int Id>
+        void add(Entity e, Type c)
+        {
+            emplace<Type, Id>(e, std::move(c));
+        }
+
+
+        /**
+         * @brief Remove a component from an entity, and update its subscriptions to the systems that depend on it.
+         * The entity (and its other components) is moved to the archetype without the removed component.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         */
+        template<int Id>
+        void remove(Entity e)
+        {
+            assert(has<Id>(e) && "ECSA ERROR: component not found!");
+            move(e, previous_archetype(_archetype_of[e], Id));
+            this->refresh(e, Id);
+        }
+
+
+        /**
+         * @brief Get a reference to the component of an entity.
+         * The reference is invalidated when a component is added to or removed from the entity,
+         * or when an entity of the same archetype is destroyed.
+         * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return Type&
+         */
+        template<typename Type, int Id>
+        [[nodiscard]] Type & get(Entity e)
+        {
+            assert(has<Id>(e) && "ECSA ERROR: component not found!");
+            Archetype & archetype = *(_archetypes[_archetype_of[e]]);
+            int row = _row_of[e];
+            Chunk * chunk = archetype.chunks[row / ChunkEntities];
+            return ((Type *) (chunk->_data + archetype.offsets[Id]))[row % ChunkEntities];
+        }
+
+
+        /**
+         * @brief Tells if an entity has a certain component.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        template<int Id>
+        [[nodiscard]] bool has(Entity e)
+        {
+            return _archetypes[_archetype_of[e]]->signature.contains(Id);
+        }
+
+
+        /**
+         * @brief Returns the signature of an entity (the set of components it owns), which is the signature of its archetype.
+         * 
+         * @param e The Id of the entity.
+         * @return Signature<Components>& 
+         */
+        [[nodiscard]] Signature<Components> & signature(Entity e)
+        {
+            return _archetypes[_archetype_of[e]]->signature;
+        }
+
+
+        /**
+         * @brief Call a function on every non-empty chunk whose entities own (at least) a certain set of components.
+         * This allows to process components by iterating linearly on contiguous arrays.
+         * 
+         * @tparam Ids The Ids of the required components.
+         * @tparam Func The type of the function, taking a `Chunk &` argument.
+         * @param func The function.
+         */
+        template<int... Ids, typename Func>
+        void chunks(Func func)
+        {
+            Signature<Components> required;
+            (required.add(Ids), ...);
+            for (int a = 0; a < _archetype_count; a++)
+            {
+                Archetype & archetype = *(_archetypes[a]);
+                if (!archetype.signature.contains_all(required))
+                    continue;
+                for (int i = 0; i < archetype.chunk_count; i++)
+                {
+                    if (archetype.chunks[i]->_size > 0)
+                        func(*(archetype.chunks[i]));
+                }
+            }
+        }
+
+
+        /**
+         * @brief Tells the number of archetypes currently in the table.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int archetypes()
+        {
+            return _archetype_count;
+        }
+
+
+        /**
+         * @brief Destructor.
+         * 
+         */
+        ~ArchetypeTable()
+        {
+            for (int a = 0; a < _archetype_count; a++)
+            {
+                Archetype * archetype = _archetypes[a];
+                for (int row = 0; row < archetype->size; row++)
+                {
+                    for (int c = 0; c < Components; c++)
+                    {
+                        if (archetype->offsets[c] >= 0)
+                            _columns[c].destroy(slot(a, row, c));
+                    }
+                }
+                for (int i = 0; i < archetype->chunk_count; i++)
+                {
+                    delete [] archetype->chunks[i]->_data;
+                    delete archetype->chunks[i];
+                }
+                delete archetype;
+            }
+        }
+
+
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,1470 @@
+#ifndef ECSA_BASIC_TABLE_H
+#define ECSA_BASIC_TABLE_H
+
+#include <cassert>
+#include <tuple>
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    template<typename Table, int Entities, int Components, int Systems>
+    class BasicTable
+    {
+        public:
+
+
+        /**
+         * @brief The systems the entities with a certain signature belong to, found once by `subscribers`
+         * so that `spawn` does not need to check every system for every set of new entities.
+         * 
+         */
+        struct Subscribers
+        {
+            /**
+             * @brief The components owned by the entities.
+             * 
+             */
+            Signature<Components> signature;
+
+
+            /**
+             * @brief The Ids of the declarative systems all the entities belong to.
+             * 
+             */
+            Array<int, Systems> members;
+            int members_count;
+
+
+            /**
+             * @brief The Ids of the systems that check each entity with `select`
+             * (the declarative systems that also filter with it, and the systems that only implement it).
+             * 
+             */
+            Array<int, Systems> candidates;
+            int candidates_count;
+
+
+            /**
+             * @brief The number of systems in the table when the lists were built.
+             * 
+             */
+            int systems;
+        };
+
+
+        protected:
+
+
+        /**
+         * @brief The systems associated to the table.
+         * 
+         */
+        Array<ISystem *, Systems> _systems;
+
+
+        /**
+         * @brief The number of systems added to the table.
+         * 
+         */
+        int _system_count;
+
+
+        /**
+         * @brief The components required and excluded by each declarative system.
+         * 
+         */
+        Array<Signature<Components>, Systems> _required;
+        Array<Signature<Components>, Systems> _excluded;
+
+
+        /**
+         * @brief For each component, the Ids of the declarative systems whose membership depends on it.
+         * 
+         */
+        Array<Array<int, Systems>, Components> _dependents;
+        Array<int, Components> _dependents_count;
+
+
+        /**
+         * @brief The Ids of the systems that implement `select`.
+         * 
+         */
+        Array<int, Systems> _selective;
+        int _selective_count;
+
+
+        /**
+         * @brief The entities passed to `subscribe`, whose subscriptions to the systems
+         * that implement `select` are kept up to date when their components change.
+         * 
+         */
+        EntityMask<Entities> _tracked;
+
+
+        /**
+         * @brief The generation of each entity slot, incremented every time the entity in the slot is destroyed.
+         * 
+         */
+        Array<unsigned int, Entities> _generations;
+
+
+        /**
+         * @brief The structural changes recorded with `defer`, applied by `flush`.
+         * 
+         */
+        CommandBuffer<Table, Entities> _commands;
+
+
+        /**
+         * @brief Number of entities in each page of `_changes`.
+         * 
+         */
+        static constexpr int ChangePageEntities = 32;
+        static constexpr int ChangePages = Entities == 0 ? 1 : ((Entities - 1) / ChangePageEntities + 1);
+
+
+        /**
+         * @brief For each component, the tick at which the component of each entity was last added or changed.
+         * Pages are allocated the first time a component is added to one of their entities,
+         * and the ticks are only meaningful for the entities that own the component.
+         * 
+         */
+        Array<Array<unsigned int *, ChangePages>, Components> _changes;
+
+
+        /**
+         * @brief The current tick, incremented every time a system is updated.
+         * 
+         */
+        unsigned int _tick;
+
+
+        /**
+         * @brief The tick at which each system was last updated.
+         * 
+         */
+        Array<unsigned int, Systems> _last_run;
+
+
+        /**
+         * @brief The Id of the system being updated, or -1 outside of `update`
+         * (and while several systems are updated at the same time, see `changed<Id>(system)`).
+         * 
+         */
+        int _running;
+
+
+        /**
+         * @brief The signatures of the components each system reads and writes in `update`.
+         * 
+         */
+        Array<Signature<Components>, Systems> _reads;
+        Array<Signature<Components>, Systems> _writes;
+
+
+        /**
+         * @brief Runs the systems that do not conflict at the same time (`nullptr` to run them one after another).
+         * 
+         */
+        Executor * _executor;
+
+
+        /**
+         * @brief Tells if several systems are being updated at the same time.
+         * 
+         */
+        bool _parallel;
+
+
+        /**
+         * @brief For each component, the first of the indexes on its fields (the others are linked with `IIndex::next`).
+         * 
+         */
+        Array<IIndex *, Components> _indexes;
+
+
+        /**
+         * @brief Tells if components are being added to new entities by `spawn`, which subscribes them all at once.
+         * 
+         */
+        bool _spawning;
+
+
+        /**
+         * @brief Tells if the entities recorded with `defer` are being destroyed by `flush`,
+         * which unsubscribes them all at once.
+         * 
+         */
+        bool _flushing;
+
+
+        /**
+         * @brief Returns a reference to the actual table.
+         * 
+         * @return Table& 
+         */
+        [[nodiscard]] Table & table()
+        {
+            return static_cast<Table &>(*this);
+        }
+
+
+        /**
+         * @brief Tells if an entity matches the components declared by a system
+         * (and its `select` function, for the systems that also filter with it).
+         * 
+         * @param i The Id of the system.
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool matches(int i, Entity e)
+        {
+            Signature<Components> & signature = table().signature(e);
+            if (!signature.contains_all(_required[i]) || signature.contains_any(_excluded[i]))
+                return false;
+            return !_systems[i]->filtered() || _systems[i]->select(e);
+        }
+
+
+        /**
+         * @brief Mark the component of an entity as changed at the current tick.
+         * 
+         * @param c The Id of the component.
+         * @param e The Id of the entity.
+         */
+        void stamp(int c, Entity e)
+        {
+            unsigned int *& page = _changes[c][e / ChangePageEntities];
+            if (page == nullptr)
+                page = new unsigned int [ ChangePageEntities ];
+            page[e % ChangePageEntities] = _tick;
+        }
+
+
+        /**
+         * @brief Returns the tick at which the component of an entity was last added or changed.
+         * The entity must own the component.
+         * 
+         * @param c The Id of the component.
+         * @param e The Id of the entity.
+         * @return unsigned int 
+         */
+        [[nodiscard]] unsigned int stamped(int c, Entity e)
+        {
+            return _changes[c][e / ChangePageEntities][e % ChangePageEntities];
+        }
+
+
+        /**
+         * @brief Tells if an entity owns a component that was added or changed at a certain tick or after it.
+         * 
+         * @param c The Id of the component.
+         * @param e The Id of the entity.
+         * @param since The tick.
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool modified(int c, Entity e, unsigned int since)
+        {
+            return table().signature(e).contains(c) && stamped(c, e) >= since;
+        }
+
+
+        /**
+         * @brief Subscribe an entity to a system or unsubscribe it, if its membership changed.
+         * 
+         * @param s The system.
+         * @param e The Id of the entity.
+         * @param member Tells if the entity should be subscribed to the system.
+         */
+        void sync(ISystem * s, Entity e, bool member)
+        {
+            if (member && !s->subscribed(e))
+                s->subscribe(e);
+            else if (!member && s->subscribed(e))
+                s->unsubscribe(e);
+        }
+
+
+        /**
+         * @brief Update the subscriptions of an entity after one of its components was added or removed
+         * (an added component is also marked as changed), as well as the indexes on that component.
+         * Only the declarative systems that depend on that component are checked, plus the systems
+         * that implement `select` if the entity was already subscribed with `subscribe`.
+         * 
+         * @param e The Id of the entity.
+         * @param c The Id of the component that was added or removed.
+         */
+        void refresh(Entity e, int c)
+        {
+            assert(!_parallel && "ECSA ERROR: components cannot be added or removed while systems run in parallel!");
+            if (_spawning)
+                return;
+            bool added = table().signature(e).contains(c);
+            if (added)
+                stamp(c, e);
+            for (IIndex * index = _indexes[c]; index != nullptr; index = index->next)
+            {
+                if (added)
+                    index->touch(e);
+                else
+                    index->erase(e);
+            }
+            for (int i = 0; i < _dependents_count[c]; i++)
+            {
+                int id = _dependents[c][i];
+                sync(_systems[id], e, matches(id, e));
+            }
+            if (!_tracked.contains(e))
+                return;
+            for (int i = 0; i < _selective_count; i++)
+            {
+                ISystem * s = _systems[_selective[i]];
+                sync(s, e, s->select(e));
+            }
+        }
+
+
+        /**
+         * @brief Re-evaluate the subscriptions of all the entities in the table to a system.
+         * 
+         * @param i The Id of the system.
+         */
+        void reevaluate(int i)
+        {
+            ISystem * s = _systems[i];
+            for (Entity e : table().entities())
+            {
+                if (s->declarative())
+                    sync(s, e, matches(i, e));
+                else
+                    sync(s, e, _tracked.contains(e) && s->select(e));
+            }
+            s->validate();
+        }
+
+
+        /**
+         * @brief Unsubscribe an entity from all the systems it is subscribed to.
+         * 
+         * @param e The Id of the entity.
+         */
+        void unsubscribe(Entity e)
+        {
+            for (int i = 0; i < Systems; i++)
+            {
+                ISystem * s = _systems[i];
+                if (s != nullptr && s->subscribed(e))
+                    s->unsubscribe(e);
+            }
+            _tracked.destroy(e);
+        }
+
+
+        /**
+         * @brief Returns a view over the Ids of the entities subscribed to a system.
+         * The systems of the table store them as `EntityIndex<Entities>`.
+         * 
+         * @param s The system.
+         * @return BasicEntityView<EntityIndex<Entities>> 
+         */
+        [[nodiscard]] BasicEntityView<EntityIndex<Entities>> subscribed(ISystem * s)
+        {
+            return BasicEntityView<EntityIndex<Entities>>(static_cast<const EntityIndex<Entities> *>(s->subscribed_ids()), s->subscribed_count());
+        }
+
+
+        /**
+         * @brief Unsubscribe a destroyed entity from all the systems, remove it from the indexes, and invalidate its handles.
+         * A recorded destruction of the entity is canceled, so that `flush` does not destroy another entity reusing its Id.
+         * 
+         * @param e The Id of the entity.
+         */
+        void retire(Entity e)
+        {
+            if (_flushing)
+                _tracked.destroy(e);
+            else
+            {
+                unsubscribe(e);
+                _commands.cancel(e);
+            }
+            for (int c = 0; c < Components; c++)
+            {
+                for (IIndex * index = _indexes[c]; index != nullptr; index = index->next)
+                    index->erase(e);
+            }
+            _generations[e]++;
+        }
+
+
+        /**
+         * @brief Tells if two systems must not run at the same time: one of them writes a component
+         * the other reads or writes, or one of them did not declare the components it accesses.
+         * 
+         * @param i The Id of the first system.
+         * @param j The Id of the second system.
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool conflict(int i, int j)
+        {
+            if (!_systems[i]->concurrent() || !_systems[j]->concurrent())
+                return true;
+            return _writes[i].contains_any(_writes[j]) || _writes[i].contains_any(_reads[j]) || _reads[i].contains_any(_writes[j]);
+        }
+
+
+        /**
+         * @brief The systems of a wave, passed to the executor.
+         * 
+         */
+        struct Wave
+        {
+            BasicTable * table;
+            Array<int, Systems> ids;
+            int count;
+        };
+
+
+        /**
+         * @brief Update a system of a wave (a task of the executor).
+         * 
+         * @param context The wave.
+         * @param index The position of the system in the wave.
+         */
+        static void run(void * context, int index, int)
+        {
+            Wave * wave = static_cast<Wave *>(context);
+            wave->table->_systems[wave->ids[index]]->update();
+        }
+
+
+        /**
+         * @brief Update the active systems with the executor.
+         * Each system is put in the wave after the last wave of the systems with a lower Id it conflicts with
+         * (which builds the dependency graph of the frame one level at a time), then the waves are run in order.
+         * The systems of a wave share the same tick.
+         * 
+         */
+        void schedule()
+        {
+            Array<int, Systems> waves(-1);
+            int count = 0;
+            for (int j = 0; j < Systems; j++)
+            {
+                if (_systems[j] == nullptr || !_systems[j]->active())
+                    continue;
+                int w = 0;
+                for (int i = 0; i < j; i++)
+                {
+                    if (waves[i] >= w && conflict(i, j))
+                        w = waves[i] + 1;
+                }
+                waves[j] = w;
+                if (w >= count)
+                    count = w + 1;
+            }
+            Wave wave;
+            wave.table = this;
+            for (int w = 0; w < count; w++)
+            {
+                wave.count = 0;
+                for (int i = 0; i < Systems; i++)
+                {
+                    if (waves[i] == w)
+                        wave.ids[wave.count++] = i;
+                }
+                if (wave.count == 1)
+                {
+                    _running = wave.ids[0];
+                    _systems[_running]->update();
+                    _running = -1;
+                }
+                else
+                {
+                    _parallel = true;
+                    _executor->run(&run, &wave, wave.count);
+                    _parallel = false;
+                }
+                for (int i = 0; i < wave.count; i++)
+                    _last_run[wave.ids[i]] = _tick;
+                _tick++;
+            }
+        }
+
+
+        /**
+         * @brief Unsubscribe all the entities from all the systems and empty the indexes at once,
+         * and invalidate the handles of the destroyed entities. Used by `clear`.
+         * 
+         * @param entities The mask of the entities in the table.
+         */
+        void reset(const EntityMask<Entities> & entities)
+        {
+            for (int i = 0; i < Systems; i++)
+            {
+                if (_systems[i] != nullptr)
+                    _systems[i]->clear();
+            }
+            for (int c = 0; c < Components; c++)
+            {
+                for (IIndex * index = _indexes[c]; index != nullptr; index = index->next)
+                    index->clear();
+            }
+            _tracked.clear();
+            entities.for_each([this](Entity e) {
+                _generations[e]++;
+                _commands.cancel(e);
+            });
+        }
+
+
+        /**
+         * @brief Find the systems the entities with the signature of some subscribers belong to.
+         * 
+         * @param subscribers The subscribers, whose lists are rebuilt.
+         */
+        void find(Subscribers & subscribers)
+        {
+            subscribers.members_count = 0;
+            subscribers.candidates_count = 0;
+            subscribers.systems = _system_count;
+            for (int i = 0; i < Systems; i++)
+            {
+                ISystem * s = _systems[i];
+                if (s == nullptr)
+                    continue;
+                if (s->declarative())
+                {
+                    if (!subscribers.signature.contains_all(_required[i]) || subscribers.signature.contains_any(_excluded[i]))
+                        continue;
+                    if (!s->filtered())
+                    {
+                        subscribers.members[subscribers.members_count++] = i;
+                        continue;
+                    }
+                }
+                subscribers.candidates[subscribers.candidates_count++] = i;
+            }
+        }
+
+
+        /**
+         * @brief Returns a lazy query on the entities subscribed to a system whose component with a certain Id
+         * was added or changed since the last time the system was updated (at a tick after the one of that update).
+         * 
+         * @tparam Id The Id of the component.
+         * @param i The Id of the system.
+         * @return auto A `Query` on the changed entities.
+         */
+        template<int Id>
+        [[nodiscard]] auto changed_since_run(int i)
+        {
+            unsigned int since = _last_run[i] + 1;
+            using Source = ViewSource<EntityIndex<Entities>>;
+            Query<Table, Source> query(table(), Source(subscribed(_systems[i])), std::tuple<>());
+            return query.where([this, since](Entity e) { return modified(Id, e, since); });
+        }
+
+
+        /**
+         * @brief Call a function on every entity in the table, walking its mask one word at a time (full words without testing their bits).
+         * The mask is walked here rather than with `for_each`, and this function is always inlined,
+         * so that the compiler can also inline the filtering function of a query in the loop.
+         * 
+         * @tparam Function The type of the function, taking an `Entity`.
+         * @param f The function.
+         */
+        template<typename Function>
+        [[gnu::always_inline]] inline void scan(Function f)
+        {
+            const unsigned int * words = table().entities().words();
+            for (int j = 0; j < (Entities + 31) / 32; j++)
+            {
+                unsigned int word = words[j];
+                if (word == 0xffffffff)
+                {
+                    for (Entity e = j * 32; e < j * 32 + 32; e++)
+                        f(e);
+                    continue;
+                }
+                for (; word != 0; word &= word - 1)
+                    f(j * 32 + __builtin_ctz(word));
+            }
+        }
+
+
+        public:
+
+
+        /**
+         * @brief The type of the views over the entities subscribed to a system of the table,
+         * whose Ids are stored in the narrowest type that fits `Entities`.
+         * 
+         */
+        using View = BasicEntityView<EntityIndex<Entities>>;
+
+
+        /**
+         * @brief The type of the entity bags returned by the table, whose Ids are stored in the narrowest type that fits `Entities`.
+         * 
+         * @tparam Size The maximum size of the bag.
+         */
+        template<int Size>
+        using Bag = EntityBag<Size, EntityIndex<Entities>>;
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        BasicTable() : _systems(nullptr), _system_count(0), _dependents_count(0), _selective_count(0), _generations(0),
+            _commands(static_cast<Table &>(*this)),
+            _changes(Array<unsigned int *, ChangePages>(nullptr)), _tick(1), _last_run(0), _running(-1), _executor(nullptr), _parallel(false),
+            _indexes(nullptr), _spawning(false), _flushing(false)
+        {
+
+        }
+
+
+        /**
+         * @brief Subscribe an entity to all the relevant systems in the table.
+         * Only needed for systems that implement `select`: entities are subscribed automatically
+         * to the systems that declare their components.
+         * 
+         * @param e The Id of the entity to subscribe.
+         */
+        void subscribe(Entity e)
+        {
+            for (int i = 0; i < Systems; i++)
+            {
+                ISystem * s = _systems[i];
+                if (s == nullptr || s->subscribed(e))
+                    continue;
+                if (s->declarative() ? matches(i, e) : s->select(e))
+                    s->subscribe(e);
+            }
+            _tracked.add(e);
+        }
+
+
+        /**
+         * @brief Returns a handle to an entity, which can be stored and checked later with `alive`.
+         * 
+         * @param e The Id of the entity.
+         * @return Handle 
+         */
+        [[nodiscard]] Handle handle(Entity e)
+        {
+            assert(table().contains(e) && "ECSA ERROR: entity not found!");
+            return Handle(e, _generations[e]);
+        }
+
+
+        /**
+         * @brief Tells if the entity referred to by a handle still exists.
+         * This is false once the entity has been destroyed, even if its Id has been reused by a new entity.
+         * 
+         * @param h The handle.
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool alive(Handle h)
+        {
+            if (h.entity < 0 || h.entity >= Entities)
+                return false;
+            return _generations[h.entity] == h.generation && table().contains(h.entity);
+        }
+
+
+        /**
+         * @brief Tells if an entity has all the components in a set.
+         * This is a single test on the signature of the entity, regardless of the number of components.
+         * 
+         * @tparam Ids The Ids of the components.
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false 
+         */
+        template<int... Ids>
+        [[nodiscard]] bool has_all(Entity e)
+        {
+            constexpr Signature<Components> required = Signature<Components>::template of<Ids...>();
+            return table().signature(e).contains_all(required);
+        }
+
+
+        /**
+         * @brief Tells if an entity has at least one of the components in a set.
+         * 
+         * @tparam Ids The Ids of the components.
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false 
+         */
+        template<int... Ids>
+        [[nodiscard]] bool has_any(Entity e)
+        {
+            constexpr Signature<Components> required = Signature<Components>::template of<Ids...>();
+            return table().signature(e).contains_any(required);
+        }
+
+
+        /**
+         * @brief Tells if an entity has none of the components in a set.
+         * 
+         * @tparam Ids The Ids of the components.
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false 
+         */
+        template<int... Ids>
+        [[nodiscard]] bool has_none(Entity e)
+        {
+            return !has_any<Ids...>(e);
+        }
+
+
+        /**
+         * @brief Add a system to the table.
+         * The system must be declared for the maximum number of entities of the table (the `TableEntities` of `System`).
+         * 
+         * @tparam Id The Id to assign to the system.
+         * @param s A pointer to the system, created with `new`.
+         */
+        template<int Id>
+        void add(ISystem * s)
+        {
+            assert(_systems[Id] == nullptr && "ECSA ERROR: system already exists!");
+            assert(s->table_entities() == Entities && "ECSA ERROR: system declared for a table of another size!");
+            s->activate();
+            s->signatures(_required[Id], _excluded[Id]);
+            s->access(_reads[Id], _writes[Id]);
+            s->executor(_executor);
+            _systems[Id] = s;
+            _system_count++;
+            if (!s->declarative())
+            {
+                _selective[_selective_count++] = Id;
+                return;
+            }
+            for (int c = 0; c < Components; c++)
+            {
+                if (_required[Id].contains(c) || _excluded[Id].contains(c))
+                    _dependents[c][_dependents_count[c]++] = Id;
+            }
+        }
+
+
+        /**
+         * @brief Find the systems the entities with a certain set of components belong to.
+         * 
+         * @tparam Ids The Ids of the components.
+         * @return Subscribers 
+         */
+        template<int... Ids>
+        [[nodiscard]] Subscribers subscribers()
+        {
+            Subscribers result;
+            result.signature = Signature<Components>::template of<Ids...>();
+            find(result);
+            return result;
+        }
+
+
+        /**
+         * @brief Add the same set of components to some new entities, and subscribe them all at once to the relevant systems,
+         * as `subscribe` would. The systems are the ones found by `subscribers` (found again if systems were added since):
+         * only the systems that filter with `select` check every entity.
+         * 
+         * @tparam Function The type of the function adding the components: a function, lambda or functor taking a `View`.
+         * @param entities The new entities, without components.
+         * @param subscribers The systems the entities belong to.
+         * @param build The function adding the components, which must add the components of `subscribers` to all the entities.
+         */
+        template<typename Function>
+        void spawn(View entities, Subscribers & subscribers, Function build)
+        {
+            if (subscribers.systems != _system_count)
+                find(subscribers);
+            _spawning = true;
+            build(entities);
+            _spawning = false;
+            if (entities.empty())
+                return;
+            assert(table().signature(entities[0]) == subscribers.signature && "ECSA ERROR: the entities do not have the expected components!");
+            for (int c = 0; c < Components; c++)
+            {
+                if (!subscribers.signature.contains(c))
+                    continue;
+                for (Entity e : entities)
+                    stamp(c, e);
+                for (IIndex * index = _indexes[c]; index != nullptr; index = index->next)
+                {
+                    for (Entity e : entities)
+                        index->touch(e);
+                }
+            }
+            for (int i = 0; i < subscribers.members_count; i++)
+            {
+                ISystem * s = _systems[subscribers.members[i]];
+                for (Entity e : entities)
+                    s->subscribe(e);
+            }
+            for (int i = 0; i < subscribers.candidates_count; i++)
+            {
+                ISystem * s = _systems[subscribers.candidates[i]];
+                for (Entity e : entities)
+                {
+                    if (s->select(e))
+                        s->subscribe(e);
+                }
+            }
+            for (Entity e : entities)
+                _tracked.add(e);
+        }
+
+
+        /**
+         * @brief Add an index on a field of a component to the table.
+         * The entities that already own the component are indexed on the next lookup.
+         * 
+         * @param index A pointer to the index, created with `new`.
+         */
+        void add(IIndex * index)
+        {
+            int c = index->component();
+            index->next = _indexes[c];
+            _indexes[c] = index;
+            for (Entity e : table().entities())
+            {
+                if (table().signature(e).contains(c))
+                    index->touch(e);
+            }
+        }
+
+
+        /**
+         * @brief Get a system by its Id.
+         * 
+         * @tparam Id The Id of the system.
+         * @return ISystem* 
+         */
+        template<int Id>
+        [[nodiscard]] ISystem * get()
+        {
+            assert(_systems[Id] != nullptr && "ECSA ERROR: system not found!");
+            return _systems[Id];
+        }
+
+
+        /**
+         * @brief Activate a system. (Its `update` function will be executed when `update()` is called)
+         * 
+         * @tparam Id The Id of the system to activate.
+         */
+        template<int Id>
+        void activate()
+        {
+            ISystem * s = _systems[Id];
+            s->activate();
+        }
+
+
+        /**
+         * @brief Dectivate a system. (Its `update` function will not be executed when `update()` is called)
+         * 
+         * @tparam Id The Id of the system to activate.
+         */
+        template<int Id>
+        void deactivate()
+        {
+            ISystem * s = _systems[Id];
+            s->deactivate();
+        }
+
+
+        /**
+         * @brief Activate all systems associated to the table. (Their `update` function will be executed when `update()` is called)
+         * 
+         */
+        void activate_all()
+        {
+            for (int i = 0; i < Systems; i++)
+            {
+                ISystem * s = _systems[i];
+                if (s != nullptr)
+                    s->activate();
+            }
+        }
+
+
+        /**
+         * @brief Deactivate all systems associated to the table. (Their `update` function will not be executed when `update()` is called)
+         * 
+         */
+        void deactivate_all()
+        {
+            for (int i = 0; i < Systems; i++)
+            {
+                ISystem * s = _systems[i];
+                if (s != nullptr)
+                    s->deactivate();
+            }
+        }
+
+
+        /**
+         * @brief Perform a query that returns the Ids of all the entities
+         * subscribed to a certain system.
+         * 
+         * @tparam Size The maximum number of entities processed by the system.
+         * @tparam SystemId The Id of the system.
+         * @return Bag<Size> 
+         */
+        template<int Size, int SystemId>
+        [[nodiscard]] Bag<Size> query()
+        {
+            return view<SystemId>().template collect<Size>();
+        }
+
+
+        /**
+         * @brief Returns a view over the Ids of all the entities subscribed to a certain system, without copying them.
+         * The view is valid until an entity is subscribed to the system or unsubscribed from it:
+         * use `query<Size, SystemId>()` to get a copy instead.
+         * 
+         * @tparam SystemId The Id of the system.
+         * @return View 
+         */
+        template<int SystemId>
+        [[nodiscard]] View view()
+        {
+            ISystem * s = get<SystemId>();
+            if (s->stale())
+                reevaluate(SystemId);
+            return subscribed(s);
+        }
+
+
+        /**
+         * @brief Marks the entities subscribed to a system (or cached query) as out of date:
+         * they will be re-evaluated the next time they are read through the table.
+         * Needed when the value of a component the `select` function depends on changes.
+         * 
+         * @tparam SystemId The Id of the system.
+         */
+        template<int SystemId>
+        void invalidate()
+        {
+            get<SystemId>()->invalidate();
+        }
+
+
+        /**
+         * @brief Start a lazy query on the entities subscribed to a certain system.
+         * Filters can be added with `where`, and the query is evaluated only when it is iterated
+         * (or when its results are copied with `collect`), in a single pass over the entities.
+         * 
+         * @tparam SystemId The Id of the system.
+         * @return Query<Table, ViewSource<EntityIndex<Entities>>> 
+         */
+        template<int SystemId>
+        [[nodiscard]] Query<Table, ViewSource<EntityIndex<Entities>>> from()
+        {
+            using Source = ViewSource<EntityIndex<Entities>>;
+            return Query<Table, Source>(table(), Source(view<SystemId>()), std::tuple<>());
+        }
+
+
+        /**
+         * @brief Start a lazy query on all the entities in the table.
+         * Filters can be added with `where`, and the query is evaluated only when it is iterated
+         * (or when its results are copied with `collect`), in a single pass over the entities.
+         * 
+         * @return Query<Table, TableSource<Entities>> 
+         */
+        [[nodiscard]] Query<Table, TableSource<Entities>> from()
+        {
+            return Query<Table, TableSource<Entities>>(table(), TableSource<Entities>(table().entities()), std::tuple<>());
+        }
+
+
+        /**
+         * @brief Start a lazy query on the entities in a view (for example, the result of a lookup in an `OrderedIndex`).
+         * 
+         * @tparam Index The type the Ids of the view are stored as.
+         * @param view The entities.
+         * @return Query<Table, ViewSource<Index>> 
+         */
+        template<typename Index>
+        [[nodiscard]] Query<Table, ViewSource<Index>> from(BasicEntityView<Index> view)
+        {
+            return Query<Table, ViewSource<Index>>(table(), ViewSource<Index>(view), std::tuple<>());
+        }
+
+
+        /**
+         * @brief Start a lazy query on the entities of another source (for example, the result of a lookup in a `HashIndex`).
+         * 
+         * @tparam Source The type of the source.
+         * @param source The entities.
+         * @return Query<Table, Source> 
+         */
+        template<typename Source>
+        [[nodiscard]] Query<Table, Source> from(Source source)
+        {
+            return Query<Table, Source>(table(), source, std::tuple<>());
+        }
+
+
+        /**
+         * @brief Perform a query on the whole table, using a `bool` function for filtering.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The expected maximum number of entites the query will find.
+         * @param func A pointer to the function used as a fltering condition.
+         * @return Bag<Size> 
+         */
+        template<int Size>
+        [[nodiscard]] Bag<Size> query(bool (* func) (Table &, Entity))
+        {
+            Bag<Size> result;
+            // the lambda is always inlined too (the standard attribute syntax does not apply to lambdas in GCC)
+            scan([this, func, &result](Entity e) __attribute__((always_inline)) {
+                if ((*func)(table(), e))
+                    result.push_back(e);
+            });
+            return result;
+        }
+
+
+        /**
+         * @brief Perform an optimized query on the whole table.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites expected to be retrieved by the query.
+         * @param func A pointer to the function used for filtering.
+         * @return EntityBag<Size> 
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (Table &))
+        {
+            return (*func)(table());
+        }
+
+
+        /**
+         * @brief Perform a query on the whole table, using a `bool` function for filtering.
+         * Allows also to pass a parameter of any type for dynamic filtering.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The expected maximum number of entites the query will find.
+         * @tparam ParamType The type of the parameter used for filtering.
+         * @param func A pointer to the function used as a filtering condition.
+         * @param param A refernece to the parameter used for dynamic filtering.
+         * @return Bag<Size> 
+         */
+        template<int Size, typename ParamType>
+        [[nodiscard]] Bag<Size> query(bool (* func) (Table &, Entity, ParamType &), ParamType & param)
+        {
+            Bag<Size> result;
+            scan([this, func, &param, &result](Entity e) __attribute__((always_inline)) {
+                if ((*func)(table(), e, param))
+                    result.push_back(e);
+            });
+            return result;
+        }
+
+
+        /**
+         * @brief Perform an optimized query on the whole table.
+         * Allows also to pass a parameter of any type for dynamic filtering.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites expected to be retrieved by the query.
+         * @tparam ParamType The type of the parameter used for filtering.
+         * @param func A pointer to the function used for filtering.
+         * @param param A refernece to the parameter used for dynamic filtering.
+         * @return EntityBag<Size> 
+         */
+        template<int Size, typename ParamType>
+        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (Table &, ParamType &), ParamType & param)
+        {
+            return (*func)(table(), param);
+        }
+
+
+        /**
+         * @brief Perform a query on the subset of entities processed by a certain system, 
+         * using a `bool` function for filtering.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites processed by the system.
+         * @tparam SystemId The Id of the system.
+         * @param func A pointer to the function used as a filtering condition.
+         * @return Bag<Size> 
+         */
+        template<int Size, int SystemId>
+        [[nodiscard]] Bag<Size> query(bool (* func) (Table &, Entity))
+        {
+            Bag<Size> result;
+            for (Entity e : view<SystemId>())
+            {
+                if ((*func)(table(), e))
+                    result.push_back(e);
+            }
+            return result;
+        }
+
+
+        /**
+         * @brief Perform an optimized query on the subset of entities processed by a certain system.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites processed by the system.
+         * @tparam SystemId The Id of the system.
+         * @param func A pointer to the function used as a filtering condition.
+         * @return EntityBag<Size> 
+         */
+        template<int Size, int SystemId>
+        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (Table &, EntityBag<Size> &))
+        {
+            EntityBag<Size> ids = view<SystemId>().template collect<Size>();
+            return (*func)(table(), ids);
+        }
+
+
+        /**
+         * @brief Perform an optimized query on the subset of entities processed by a certain system.
+         * The function iterates directly on the entities subscribed to the system, without copying them.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites expected to be retrieved by the query.
+         * @tparam SystemId The Id of the system.
+         * @param func A pointer to the function used for filtering.
+         * @return EntityBag<Size> 
+         */
+        template<int Size, int SystemId>
+        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (Table &, View))
+        {
+            return (*func)(table(), view<SystemId>());
+        }
+
+        
+        /**
+         * @brief Perform a query on the subset of entities processed by a certain system, 
+         * using a `bool` function for filtering.
+         * Allows also to pass a parameter of any type for dynamic filtering.
+         * Returns an EntityBag with the ids of the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites processed by the system.
+         * @tparam SystemId The Id of the system.
+         * @tparam ParamType The type of the parameter used for filtering.
+         * @param func A pointer to the function used as a filtering condition.
+         * @param param A refernece to the parameter used for dynamic filtering.
+         * @return Bag<Size> 
+         */
+        template<int Size, int SystemId, typename ParamType>
+        [[nodiscard]] Bag<Size> query(bool (* func) (Table &, Entity, ParamType &), ParamType & param)
+        {
+            Bag<Size> result;
+            for (Entity e : view<SystemId>())
+            {
+                if ((*func)(table(), e, param))
+                    result.push_back(e);
+            }
+            return result;
+        }
+
+
+        /**
+         * @brief Perform an optimized query on the subset of entities processed by a certain system.
+         * Allows also to pass a parameter of any type for dynamic filtering.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites processed by the system.
+         * @tparam SystemId The Id of the system.
+         * @tparam ParamType The type of the parameter used for filtering.
+         * @param func A pointer to the function used for filtering.
+         * @param param A refernece to the parameter used for filtering.
+         * @return EntityBag<Size> 
+         */
+        template<int Size, int SystemId, typename ParamType>
+        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (Table &, EntityBag<Size> &, ParamType &), ParamType & param)
+        {
+            EntityBag<Size> ids = view<SystemId>().template collect<Size>();
+            return (*func)(table(), ids, param);
+        }
+
+
+        /**
+         * @brief Perform an optimized query on the subset of entities processed by a certain system.
+         * The function iterates directly on the entities subscribed to the system, without copying them.
+         * Allows also to pass a parameter of any type for dynamic filtering.
+         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * 
+         * @tparam Size The maximum number of entites expected to be retrieved by the query.
+         * @tparam SystemId The Id of the system.
+         * @tparam ParamType The type of the parameter used for filtering.
+         * @param func A pointer to the function used for filtering.
+         * @param param A refernece to the parameter used for filtering.
+         * @return EntityBag<Size> 
+         */
+        template<int Size, int SystemId, typename ParamType>
+        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (Table &, View, ParamType &), ParamType & param)
+        {
+            return (*func)(table(), view<SystemId>(), param);
+        }
+
+
+        /**
+         * @brief Initialize all the systems in the table.
+         * 
+         */
+        void init()
+        {
+            for (int i = 0; i < Systems; i++)
+            {
+                ISystem * s = _systems[i];
+                if (s != nullptr)
+                    s->init();
+            }
+        }
+
+
+        /**
+         * @brief Run the systems with an executor: the systems that declared the components they access with `access`
+         * and do not conflict are then updated at the same time, and the systems can use it in `parallel_for_each`.
+         * Pass `nullptr` to update them one after another again.
+         * 
+         * @param executor The executor, which must outlive the table (or be replaced before being destroyed).
+         */
+        void executor(Executor * executor)
+        {
+            _executor = executor;
+            for (int i = 0; i < Systems; i++)
+            {
+                if (_systems[i] != nullptr)
+                    _systems[i]->executor(executor);
+            }
+        }
+
+
+        /**
+         * @brief Update all the (active) systems in the table.
+         * Without an executor, the systems are updated one after another, in the order of their Ids.
+         * With an executor, they are split in waves of systems that do not conflict, which run at the same time:
+         * a system always runs after the systems with a lower Id it conflicts with.
+         * 
+         */
+        void update()
+        {
+            if (_executor == nullptr)
+            {
+                for (int i = 0; i < Systems; i++)
+                {
+                    ISystem * s = _systems[i];
+                    if (s != nullptr && s->active())
+                    {
+                        _running = i;
+                        s->update();
+                        _last_run[i] = _tick++;
+                    }
+                }
+            }
+            else
+                schedule();
+            _running = -1;
+            flush();
+        }
+
+
+        /**
+         * @brief Get a reference to the component of an entity, and mark it as changed.
+         * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return Type& 
+         */
+        template<typename Type, int Id>
+        [[nodiscard]] Type & get_mut(Entity e)
+        {
+            mark_changed<Id>(e);
+            return table().template get<Type, Id>(e);
+        }
+
+
+        /**
+         * @brief Mark the component of an entity as changed. The indexes on the component re-index the entity on their next lookup.
+         * The change tick of a component that the entity owns is only written, so this can be called from the chunks
+         * of `parallel_for_each` on their own entities, unless the component has an index.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         */
+        template<int Id>
+        void mark_changed(Entity e)
+        {
+            assert(table().template has<Id>(e) && "ECSA ERROR: component not found!");
+            assert((_indexes[Id] == nullptr || _running < 0 || !_systems[_running]->chunking())
+                && "ECSA ERROR: indexed components cannot be changed in parallel_for_each!");
+            stamp(Id, e);
+            for (IIndex * index = _indexes[Id]; index != nullptr; index = index->next)
+                index->touch(e);
+        }
+
+
+        /**
+         * @brief Returns the current tick. Components changed from now on will be reported by `changed<Id>(since)`
+         * when passing this value.
+         * 
+         * @return unsigned int 
+         */
+        [[nodiscard]] unsigned int tick()
+        {
+            return _tick;
+        }
+
+
+        /**
+         * @brief Returns a lazy query on the entities subscribed to the system being updated, whose component with a certain Id
+         * was added or changed since the last time the system was updated (at a tick after the one of that update).
+         * Can only be used inside the `update` function of a system, and not while several systems run at the same time:
+         * use `changed<Id>(this)` in systems that can run alongside others.
+         * 
+         * @tparam Id The Id of the component.
+         * @return auto A `Query` on the changed entities.
+         */
+        template<int Id>
+        [[nodiscard]] auto changed()
+        {
+            assert(_running >= 0 && "ECSA ERROR: changed<Id>() can only be used while a single system is updated, use changed<Id>(this)!");
+            return changed_since_run<Id>(_running);
+        }
+
+
+        /**
+         * @brief Returns a lazy query on the entities subscribed to a system, whose component with a certain Id
+         * was added or changed since the last time the system was updated (at a tick after the one of that update).
+         * Called from the `update` function of the system as `changed<Id>(this)`, it also works while several systems
+         * run at the same time, as long as the system declared that it reads the component.
+         * 
+         * @tparam Id The Id of the component.
+         * @tparam SystemType The type of the system.
+         * @param system The system.
+         * @return auto A `Query` on the changed entities.
+         */
+        template<int Id, typename SystemType>
+        [[nodiscard]] auto changed(SystemType * system)
+        {
+            int i = 0;
+            while (i < Systems && _systems[i] != system)
+                i++;
+            assert(i < Systems && "ECSA ERROR: system not found!");
+            assert((!_parallel || _reads[i].contains(Id) || _writes[i].contains(Id))
+                && "ECSA ERROR: changed<Id>(this) can only be used on the components declared by the system!");
+            return changed_since_run<Id>(i);
+        }
+
+
+        /**
+         * @brief Returns a lazy query on all the entities in the table whose component with a certain Id was added or changed
+         * at a certain tick or after it (see `tick()`).
+         * 
+         * @tparam Id The Id of the component.
+         * @param since The tick.
+         * @return auto A `Query` on the changed entities.
+         */
+        template<int Id>
+        [[nodiscard]] auto changed(unsigned int since)
+        {
+            return from().where([this, since](Entity e) { return modified(Id, e, since); });
+        }
+
+
+        /**
+         * @brief Returns the command buffer of the table, used to record structural changes
+         * (creating and destroying entities, adding and removing components) while systems are iterating on entities.
+         * The changes are applied by `flush`, which is called at the end of `update`.
+         * 
+         * @return CommandBuffer<Table, Entities>& 
+         */
+        [[nodiscard]] CommandBuffer<Table, Entities> & defer()
+        {
+            assert(!_parallel && "ECSA ERROR: changes cannot be deferred while systems run in parallel!");
+            return _commands;
+        }
+
+
+        /**
+         * @brief Apply the changes recorded with `defer`.
+         * Component changes are applied first, in the order they were recorded (skipping the entities destroyed in the meantime).
+         * Then, the destroyed entities are unsubscribed from each system in a single pass, before being removed from the table
+         * in increasing order.
+         * 
+         */
+        void flush()
+        {
+            _commands.apply();
+            if (_commands.destroyed_count() > 0)
+            {
+                const EntityMask<Entities> & destroyed = _commands.destroyed();
+                for (int i = 0; i < Systems; i++)
+                {
+                    ISystem * s = _systems[i];
+                    if (s != nullptr)
+                        s->unsubscribe(destroyed.words());
+                }
+                _flushing = true;
+                destroyed.for_each([this](Entity e) { table().destroy(e); });
+                _flushing = false;
+            }
+            _commands.clear();
+        }
+
+
+        /**
+         * @brief Returns the maximum number of entities the table can contain.
+         * 
+         * @return constexpr int 
+         */
+        [[nodiscard]] static constexpr int capacity()
+        {
+            return Entities;
+        }
+
+
+        /**
+         * @brief Destructor.
+         * 
+         */
+        ~BasicTable()
+        {
+            for (int s = 0; s < Systems; s++)
+                delete _systems[s];
+            for (int c = 0; c < Components; c++)
+            {
+                for (int p = 0; p < ChangePages; p++)
+                    delete[] _changes[c][p];
+            }
+            for (int c = 0; c < Components; c++)
+            {
+                while (_indexes[c] != nullptr)
+                {
+                    IIndex * index = _indexes[c];
+                    _indexes[c] = index->next;
+                    delete index;
+                }
+            }
+        }
+
+
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef ECSA_CACHED_QUERY_H
+#define ECSA_CACHED_QUERY_H
+
+#include "ecsa.h"
+
+namespace ecsa
+{
+    template<int TableEntities, int Size, int... RequiredIds, int... ExcludedIds>
+    class CachedQuery<TableEntities, Size, All<RequiredIds...>, None<ExcludedIds...>, void>
+        : public System<TableEntities, Size, All<RequiredIds...>, None<ExcludedIds...>>
+    {
+        public:
+
+        /**
+         * @brief Constructor.
+         * Cached queries are not processed, so they access no component and conflict with no system.
+         * 
+         */
+        CachedQuery()
+        {
+            this->_filtered = true;
+            this->_access = true;
+        }
+
+
+        /**
+         * @brief Cached queries are not processed: their results are only read through the table.
+         * 
+         */
+        void update() final
+        {
+
+        }
+
+        virtual ~CachedQuery() = default;
+
+    };
+
+
+    template<int TableEntities, int Size, typename Required, typename Excluded, typename ParamType>
+    class CachedQuery : public CachedQuery<TableEntities, Size, Required, Excluded, void>
+    {
+        /**
+         * @brief The parameter of the query.
+         * 
+         */
+        ParamType _param;
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        CachedQuery() : _param()
+        {
+
+        }
+
+
+        /**
+         * @brief Returns the current parameter of the query.
+         * 
+         * @return const ParamType& 
+         */
+        [[nodiscard]] const ParamType & parameter()
+        {
+            return _param;
+        }
+
+
+        /**
+         * @brief Sets the parameter of the query.
+         * The results are re-evaluated (the next time they are read) only if the parameter actually changed.
+         * 
+         * @param param The new parameter.
+         */
+        void parameter(const ParamType & param)
+        {
+            if (_param == param)
+                return;
+            _param = param;
+            this->invalidate();
+        }
+
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,454 @@
+#ifndef ECSA_COMMAND_BUFFER_H
+#define ECSA_COMMAND_BUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    template<typename Table, int Entities>
+    class CommandBuffer
+    {
+        /**
+         * @brief Base class for a recorded change to the components of an entity.
+         * The entity is referred to by a handle, so that the change is not applied to another entity reusing its Id.
+         * 
+         */
+        class ICommand
+        {
+            public:
+
+            Handle h;
+            ICommand * next;
+
+            ICommand(Handle h) : h(h), next(nullptr)
+            {
+
+            }
+
+            virtual void apply(Table & t) = 0;
+
+            virtual ~ICommand() = default;
+        };
+
+
+        /**
+         * @brief Adds a component allocated with `new` to an entity.
+         * The component is deleted if the command is never applied.
+         * 
+         */
+        template<int Id>
+        class AddCommand : public ICommand
+        {
+            Component * _component;
+
+            public:
+
+            AddCommand(Handle h, Component * c) : ICommand(h), _component(c)
+            {
+
+            }
+
+            void apply(Table & t) override
+            {
+                t.template add<Id>(this->h.entity, _component);
+                _component = nullptr;
+            }
+
+            ~AddCommand()
+            {
+                delete _component;
+            }
+        };
+
+
+        /**
+         * @brief Constructs a component of an entity in the table, from a copy kept in the command.
+         * 
+         */
+        template<typename Type, int Id>
+        class EmplaceCommand : public ICommand
+        {
+            Type _component;
+
+            public:
+
+            template<typename... Args>
+            EmplaceCommand(Handle h, Args &&... args) : ICommand(h), _component(std::forward<Args>(args)...)
+            {
+
+            }
+
+            void apply(Table & t) override
+            {
+                t.template emplace<Type, Id>(this->h.entity, std::move(_component));
+            }
+        };
+
+
+        /**
+         * @brief Removes a component from an entity.
+         * 
+         */
+        template<int Id>
+        class RemoveCommand : public ICommand
+        {
+            public:
+
+            RemoveCommand(Handle h) : ICommand(h)
+            {
+
+            }
+
+            void apply(Table & t) override
+            {
+                t.template remove<Id>(this->h.entity);
+            }
+        };
+
+
+        /**
+         * @brief Header of each block of memory where commands are recorded. The commands follow the header in memory.
+         * 
+         */
+        struct Block
+        {
+            Block * next;
+            int size;
+        };
+
+
+        /**
+         * @brief Size in bytes of the block header, padded so that the first command is suitably aligned.
+         * 
+         */
+        static constexpr int _header_size = (sizeof(Block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+
+        /**
+         * @brief The table the changes are applied to.
+         * 
+         */
+        Table & _table;
+
+
+        /**
+         * @brief List of all the blocks allocated by the buffer, which are kept and reused once the commands are discarded.
+         * 
+         */
+        Block * _blocks;
+
+
+        /**
+         * @brief The block where the next command is recorded, and the number of bytes already used in it.
+         * 
+         */
+        Block * _block;
+        int _used;
+
+
+        /**
+         * @brief The recorded component changes, in the order they were recorded.
+         * 
+         */
+        ICommand * _first;
+        ICommand * _last;
+
+
+        /**
+         * @brief The entities to destroy, and their number.
+         * 
+         */
+        EntityMask<Entities> _destroyed;
+        int _destroyed_count;
+
+
+        /**
+         * @brief Get memory for a command in the current block, moving to the next block (or allocating a new one)
+         * if it does not fit.
+         * 
+         * @param size The size in bytes of the command.
+         * @param align The alignment of the command.
+         * @return void*
+         */
+        [[nodiscard]] void * allocate(int size, int align)
+        {
+            assert(align <= (int) alignof(std::max_align_t) && "ECSA ERROR: over-aligned types are not supported by command buffers!");
+            while (true)
+            {
+                if (_block != nullptr)
+                {
+                    int offset = (_used + align - 1) / align * align;
+                    if (offset + size <= _block->size)
+                    {
+                        _used = offset + size;
+                        return (unsigned char *) _block + _header_size + offset;
+                    }
+                    if (_block->next != nullptr)
+                    {
+                        _block = _block->next;
+                        _used = 0;
+                        continue;
+                    }
+                }
+                grow(size);
+            }
+        }
+
+
+        /**
+         * @brief Allocate a new block at the end of the list, and make it the current one.
+         * 
+         * @param size The size in bytes of the command that did not fit in the other blocks.
+         */
+        void grow(int size)
+        {
+            if (size < BlockBytes)
+                size = BlockBytes;
+            Block * block = (Block *) new unsigned char[_header_size + size];
+            block->next = nullptr;
+            block->size = size;
+            if (_block == nullptr)
+                _blocks = block;
+            else
+                _block->next = block;
+            _block = block;
+            _used = 0;
+        }
+
+
+        /**
+         * @brief Record a command in the blocks of the buffer, and append it to the list.
+         * 
+         * @tparam Command The type of the command.
+         * @tparam Args The types of the arguments passed to the command's constructor.
+         * @param args The arguments passed to the command's constructor.
+         */
+        template<typename Command, typename... Args>
+        void push(Args &&... args)
+        {
+            ICommand * c = new (allocate(sizeof(Command), alignof(Command))) Command(std::forward<Args>(args)...);
+            if (_last == nullptr)
+                _first = c;
+            else
+                _last->next = c;
+            _last = c;
+        }
+
+
+        /**
+         * @brief Destroy the recorded commands, and reuse their blocks from the start.
+         * 
+         * @param run Tells if the commands are applied to the table before being destroyed.
+         */
+        void discard(bool run)
+        {
+            while (_first != nullptr)
+            {
+                ICommand * c = _first;
+                _first = c->next;
+                if (run && _table.alive(c->h))
+                    c->apply(_table);
+                c->~ICommand();
+            }
+            _last = nullptr;
+            _block = _blocks;
+            _used = 0;
+        }
+
+
+        public:
+
+
+        /**
+         * @brief Size in bytes of the blocks where commands are recorded (bigger commands get a block of their own).
+         * 
+         */
+        static constexpr int BlockBytes = 1024;
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param t The table the changes are applied to.
+         */
+        CommandBuffer(Table & t) : _table(t), _blocks(nullptr), _block(nullptr), _used(0), _first(nullptr), _last(nullptr), _destroyed_count(0)
+        {
+
+        }
+
+
+        CommandBuffer(const CommandBuffer &) = delete;
+        CommandBuffer & operator=(const CommandBuffer &) = delete;
+
+
+        /**
+         * @brief Create a new entity and return its Id.
+         * The Id is reserved right away, but the entity has no components (so it is not processed by any system)
+         * until the components added through the buffer are applied.
+         * 
+         * @return Entity
+         */
+        [[nodiscard]] Entity create()
+        {
+            return _table.create();
+        }
+
+
+        /**
+         * @brief Record the destruction of an entity.
+         * If the entity is destroyed directly before the changes are applied, the recorded destruction is canceled.
+         * 
+         * @param e The Id of the entity.
+         */
+        void destroy(Entity e)
+        {
+            assert(_table.contains(e) && "ECSA ERROR: entity not found!");
+            if (_destroyed.contains(e))
+                return;
+            _destroyed.add(e);
+            _destroyed_count++;
+        }
+
+
+        /**
+         * @brief Cancel the recorded destruction of an entity (if any), because it was destroyed directly.
+         * 
+         * @param e The Id of the entity.
+         */
+        void cancel(Entity e)
+        {
+            if (_destroyed_count == 0 || !_destroyed.contains(e))
+                return;
+            _destroyed.destroy(e);
+            _destroyed_count--;
+        }
+
+
+        /**
+         * @brief Record the addition of a component to an entity.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @param c A pointer to the component, created with `new`.
+         */
+        template<int Id>
+        void add(Entity e, Component * c)
+        {
+            push<AddCommand<Id>>(_table.handle(e), c);
+        }
+
+
+        /**
+         * @brief Record the construction of a component of an entity.
+         * The arguments are used right away to build a copy of the component, which is moved to the table later.
+         * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @tparam Args The types of the arguments passed to the component's constructor.
+         * @param e The Id of the entity.
+         * @param args The arguments passed to the component's constructor.
+         */
+        template<typename Type, int Id, typename... Args>
+        void emplace(Entity e, Args &&... args)
+        {
+            push<EmplaceCommand<Type, Id>>(_table.handle(e), std::forward<Args>(args)...);
+        }
+
+
+        /**
+         * @brief Record the removal of a component from an entity.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         */
+        template<int Id>
+        void remove(Entity e)
+        {
+            push<RemoveCommand<Id>>(_table.handle(e));
+        }
+
+
+        /**
+         * @brief Tells if no change has been recorded.
+         * 
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool empty()
+        {
+            return _first == nullptr && _destroyed_count == 0;
+        }
+
+
+        /**
+         * @brief Apply the recorded component changes to the table, in the order they were recorded,
+         * and discard them. The changes to entities destroyed in the meantime are skipped.
+         * 
+         */
+        void apply()
+        {
+            discard(true);
+        }
+
+
+        /**
+         * @brief Tells the number of entities whose destruction was recorded.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int destroyed_count()
+        {
+            return _destroyed_count;
+        }
+
+
+        /**
+         * @brief Returns the mask of the entities whose destruction was recorded.
+         * 
+         * @return const EntityMask<Entities>&
+         */
+        [[nodiscard]] const EntityMask<Entities> & destroyed()
+        {
+            return _destroyed;
+        }
+
+
+        /**
+         * @brief Discard all the recorded changes.
+         * 
+         */
+        void clear()
+        {
+            discard(false);
+            if (_destroyed_count > 0)
+                _destroyed.clear();
+            _destroyed_count = 0;
+        }
+
+
+        /**
+         * @brief Destructor.
+         * 
+         */
+        ~CommandBuffer()
+        {
+            clear();
+            while (_blocks != nullptr)
+            {
+                Block * block = _blocks;
+                _blocks = block->next;
+                delete [] (unsigned char *) block;
+            }
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
@@ -8,14 +8,14 @@
 
 namespace ecsa
 {
-    template<int MaxSize>
+    template<int MaxSize, typename Index>
     class EntityBag
     {
         /**
          * @brief Actual array of entity IDs.
          * 
          */
-        Entity _ids [ MaxSize == 0 ? 1 : MaxSize ];
+        Index _ids [ MaxSize == 0 ? 1 : MaxSize ];
 
 
         /**
@@ -25,6 +25,10 @@ namespace ecsa
         int _size;
 
 
+        template<int, typename>
+        friend class EntityBag;
+
+
         public:
 
 
@@ -38,6 +42,21 @@ namespace ecsa
         }
 
 
+        /**
+         * @brief Copies a bag storing its IDs as another type (for example, a bag returned by a table into an `EntityBag<MaxSize>`).
+         * 
+         * @tparam OtherIndex The type the IDs of the other bag are stored as.
+         * @param other The other bag.
+         */
+        template<typename OtherIndex>
+        EntityBag(const EntityBag<MaxSize, OtherIndex> & other)
+        {
+            _size = 0;
+            for (int i = 0; i < other._size; i++)
+                push_back(other._ids[i]);
+        }
+
+
         /**
          * @brief Tells if the bag is full.
          * 
@@ -69,7 +88,8 @@ namespace ecsa
         void push_back(Entity value)
         {
             assert(!full() && "ECSA ERROR: entity bag is full!");
-            _ids[_size] = value;
+            assert(static_cast<Entity>(static_cast<Index>(value)) == value && "ECSA ERROR: entity ID too large for the bag!");
+            _ids[_size] = static_cast<Index>(value);
             _size++;
         }
 
@@ -124,9 +144,9 @@ namespace ecsa
         /**
          * @brief Beginning of bag (iterator).
          * 
-         * @return Type* 
+         * @return Index* 
          */
-        [[nodiscard]] Entity * begin()
+        [[nodiscard]] Index * begin()
         {
             return _ids;
         }
@@ -135,9 +155,9 @@ namespace ecsa
         /**
          * @brief End of bag (iterator).
          * 
-         * @return Type* 
+         * @return Index* 
          */
-        [[nodiscard]] Entity * end()
+        [[nodiscard]] Index * end()
         {
             return _ids + _size;
         }
@@ -158,9 +178,9 @@ namespace ecsa
          * @brief Returns a reference to an entiy ID of the bag at a certain index.
          * 
          * @param index
-         * @return Type& 
+         * @return Index& 
          */
-        [[nodiscard]] Entity & operator[](int i)
+        [[nodiscard]] Index & operator[](int i)
         {
             assert(i < _size && "ECSA ERROR: index of EntityBag out of range!");
             return _ids[i];
@@ -10,47 +10,249 @@ namespace ecsa
     template<int Entities>
     class EntityMask
     {
+        /**
+         * @brief Number of 32-bit words in the mask.
+         * 
+         */
+        static constexpr int Words = Entities == 0 ? 1 : ((Entities - 1) / 32 + 1);
+
+
+        /**
+         * @brief Number of 32-bit words in the summary.
+         * 
+         */
+        static constexpr int SummaryWords = (Words - 1) / 32 + 1;
+
+
         /**
          * @brief The entity mask.
          * 
          */
-        int _mask [ Entities == 0 ? 1 : ((Entities - 1) / 32 + 1) ];
+        unsigned int _mask [ Words ];
+
+
+        /**
+         * @brief A mask of the words of `_mask` that are full.
+         * Used by `create` to skip 32 words at a time.
+         * 
+         */
+        unsigned int _full [ SummaryWords ];
+
+
+        /**
+         * @brief Returns the index of the lowest bit set in a word (which must not be zero).
+         * 
+         * @param word The word.
+         * @return int 
+         */
+        [[nodiscard]] static int lowest(unsigned int word)
+        {
+            return __builtin_ctz(word);
+        }
+
+
+        /**
+         * @brief Rebuilds the summary of full words after a bulk operation.
+         * 
+         */
+        void summarize()
+        {
+            for (int s = 0; s < SummaryWords; s++)
+                _full[s] = 0;
+            for (int j = 0; j < Words; j++)
+            {
+                if (_mask[j] == 0xffffffff)
+                    _full[j >> 5] |= (1u << (j & 31));
+            }
+        }
         
 
         public:
 
 
+        /**
+         * @brief Iterates on the entities present in the mask, in increasing order.
+         * Empty words are skipped, the entities of a full word are visited one after the other,
+         * and the entities of the other words are found with one step each.
+         * 
+         */
+        class iterator
+        {
+            const unsigned int * _mask;
+            Entity _e;
+            unsigned int _rest;
+
+            void next_word(int j)
+            {
+                while (j < Words && _mask[j] == 0)
+                    j++;
+                if (j >= Words)
+                {
+                    _e = Words * 32;
+                    _rest = 0;
+                    return;
+                }
+                _rest = _mask[j];
+                _e = j * 32 + lowest(_rest);
+            }
+
+            public:
+
+            iterator(const unsigned int * mask, int word) : _mask(mask)
+            {
+                next_word(word);
+            }
+
+            [[nodiscard]] Entity operator*() const
+            {
+                return _e;
+            }
+
+            iterator & operator++()
+            {
+                if (_rest == 0xffffffff)
+                {
+                    // a full word is left as it is: its entities follow each other
+                    if ((++_e & 31) == 0)
+                        next_word(_e >> 5);
+                    return *this;
+                }
+                _rest &= _rest - 1;
+                if (_rest == 0)
+                    next_word((_e >> 5) + 1);
+                else
+                    _e = (_e & ~31) + lowest(_rest);
+                return *this;
+            }
+
+            [[nodiscard]] bool operator!=(const iterator & other) const
+            {
+                // the end iterator is past the last word
+                return _e != other._e;
+            }
+        };
+
+
         /**
          * @brief Constructor.
          * 
          */
         EntityMask()
         {
-            for (int i = 0; i < Entities / 32 + 1; i++)
+            for (int i = 0; i < Words; i++)
                 _mask[i] = 0;
+            for (int i = 0; i < SummaryWords; i++)
+                _full[i] = 0;
         }
 
 
         /**
          * @brief Creates in an entity in the first free slot.
+         * The first word with a free slot is found through the summary of full words,
+         * so this takes at most one step every 32 words of the mask.
          * 
+         * @return Entity The Id of the entity, or -1 if the mask is full.
          */
         Entity create()
         {
-            for (int j = 0; j < Entities / 32 + 1; j++)
+            for (int s = 0; s < SummaryWords; s++)
             {
-                if (_mask[j] == 0xffffffff)
+                if (_full[s] == 0xffffffff)
                     continue;
-                for (Entity i = 0; i < 32; i++)
+                int j = s * 32 + lowest(~_full[s]);
+                if (j >= Words)
+                    break;
+                Entity e = j * 32 + lowest(~_mask[j]);
+                if (e >= Entities)
+                    break;
+                add(e);
+                return e;
+            }
+            return -1;
+        }
+
+
+        /**
+         * @brief Creates a contiguous run of entities in the first free run long enough.
+         * Nothing is created if there is no such run.
+         * 
+         * @param n The number of entities.
+         * @return Entity The Id of the first entity of the run, or -1 if there is no free run of `n` entities.
+         */
+        Entity create(int n)
+        {
+            assert(n > 0 && "ECSA ERROR: invalid number of entities!");
+            int start = 0;
+            int length = 0;
+            for (int j = 0; j < Words && length < n; j++)
+            {
+                unsigned int word = _mask[j];
+                if (word == 0)
+                {
+                    length += 32;
+                    continue;
+                }
+                if (word == 0xffffffff)
                 {
-                    if (((_mask[j] >> i) & 1) == 0)
+                    start = (j + 1) * 32;
+                    length = 0;
+                    continue;
+                }
+                int bit = 0;
+                while (bit < 32)
+                {
+                    unsigned int rest = word >> bit;
+                    if (rest == 0)
                     {
-                        add(j * 32 + i);
-                        return j * 32 + i;
+                        length += 32 - bit;
+                        break;
                     }
+                    int free = lowest(rest);
+                    length += free;
+                    if (length >= n)
+                        break;
+                    bit += free + lowest(~(rest >> free));
+                    start = j * 32 + bit;
+                    length = 0;
                 }
             }
-            return 0xffffffff;
+            if (length < n || start + n > Entities)
+                return -1;
+            for (Entity e = start; e < start + n; e++)
+                add(e);
+            return start;
+        }
+
+
+        /**
+         * @brief Creates a number of entities, contiguous if possible.
+         * If there is no free run long enough, the entities are created one by one in the first free slots,
+         * until the mask is full.
+         * 
+         * @tparam Size The maximum size of the entity bag.
+         * @tparam Index The type the Ids are stored as in the entity bag.
+         * @param n The number of entities.
+         * @param entities The entity bag where the Ids of the new entities are appended.
+         * @return int The number of entities created (less than `n` if the mask is full).
+         */
+        template<int Size, typename Index>
+        int create(int n, EntityBag<Size, Index> & entities)
+        {
+            Entity start = create(n);
+            if (start >= 0)
+            {
+                for (Entity e = start; e < start + n; e++)
+                    entities.push_back(e);
+                return n;
+            }
+            for (int i = 0; i < n; i++)
+            {
+                Entity e = create();
+                if (e < 0)
+                    return i;
+                entities.push_back(e);
+            }
+            return n;
         }
 
 
@@ -62,7 +264,10 @@ namespace ecsa
         void add(Entity e)
         {
             assert(e < Entities && "ECSA ERROR: entity index is out of range!");
-            _mask[ e >> 5 ] |= (1 << (e & 31));
+            int j = e >> 5;
+            _mask[j] |= (1u << (e & 31));
+            if (_mask[j] == 0xffffffff)
+                _full[j >> 5] |= (1u << (j & 31));
         }
 
 
@@ -74,7 +279,9 @@ namespace ecsa
         void destroy(Entity e)
         {
             assert(e < Entities && "ECSA ERROR: entity index is out of range!");
-            _mask[e >> 5] &= ~(1 << (e & 31));
+            int j = e >> 5;
+            _mask[j] &= ~(1u << (e & 31));
+            _full[j >> 5] &= ~(1u << (j & 31));
         }
 
 
@@ -91,6 +298,195 @@ namespace ecsa
             return ( (_mask[e >> 5] >> (e & 31)) & 1 ) == 1;
         }
 
+
+        /**
+         * @brief Marks all the entities as absent, one word at a time.
+         * 
+         */
+        void clear()
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] = 0;
+            for (int i = 0; i < SummaryWords; i++)
+                _full[i] = 0;
+        }
+
+
+        /**
+         * @brief Tells the number of entities present in the mask.
+         * 
+         * @return int 
+         */
+        [[nodiscard]] int count() const
+        {
+            int result = 0;
+            for (int i = 0; i < Words; i++)
+                result += __builtin_popcount(_mask[i]);
+            return result;
+        }
+
+
+        /**
+         * @brief Tells if at least one entity is present in the mask.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool any() const
+        {
+            unsigned int result = 0;
+            for (int i = 0; i < Words; i++)
+                result |= _mask[i];
+            return result != 0;
+        }
+
+
+        /**
+         * @brief Tells if no entity is present in the mask.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool empty() const
+        {
+            return !any();
+        }
+
+
+        /**
+         * @brief Keeps only the entities that are also present in another mask.
+         * 
+         * @param other The other mask.
+         * @return EntityMask& 
+         */
+        EntityMask & operator&=(const EntityMask & other)
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] &= other._mask[i];
+            summarize();
+            return *this;
+        }
+
+
+        /**
+         * @brief Adds the entities present in another mask.
+         * 
+         * @param other The other mask.
+         * @return EntityMask& 
+         */
+        EntityMask & operator|=(const EntityMask & other)
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] |= other._mask[i];
+            summarize();
+            return *this;
+        }
+
+
+        /**
+         * @brief Keeps the entities present in exactly one of the two masks.
+         * 
+         * @param other The other mask.
+         * @return EntityMask& 
+         */
+        EntityMask & operator^=(const EntityMask & other)
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] ^= other._mask[i];
+            summarize();
+            return *this;
+        }
+
+
+        /**
+         * @brief Removes the entities present in another mask (and-not).
+         * 
+         * @param other The other mask.
+         * @return EntityMask& 
+         */
+        EntityMask & operator-=(const EntityMask & other)
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] &= ~other._mask[i];
+            summarize();
+            return *this;
+        }
+
+
+        /**
+         * @brief Returns a 32-bit word of the mask: bit `i` of word `j` tells if entity `j * 32 + i` is present.
+         * 
+         * @param j The index of the word.
+         * @return unsigned int 
+         */
+        [[nodiscard]] unsigned int word(int j) const
+        {
+            assert(j < Words && "ECSA ERROR: word index is out of range!");
+            return _mask[j];
+        }
+
+
+        /**
+         * @brief Returns the words of the mask (see `word`).
+         * 
+         * @return const unsigned int* 
+         */
+        [[nodiscard]] const unsigned int * words() const
+        {
+            return _mask;
+        }
+
+
+        /**
+         * @brief Beginning of the entities present in the mask (iterator).
+         * 
+         * @return iterator 
+         */
+        [[nodiscard]] iterator begin() const
+        {
+            return iterator(_mask, 0);
+        }
+
+
+        /**
+         * @brief End of the entities present in the mask (iterator).
+         * 
+         * @return iterator 
+         */
+        [[nodiscard]] iterator end() const
+        {
+            return iterator(_mask, Words);
+        }
+
+
+        /**
+         * @brief Call a function on each entity present in the mask, in increasing order.
+         * Empty words are skipped, full words are visited with a plain loop, and the entities
+         * of the other words are found with one step each.
+         * 
+         * @tparam Function The type of the function: a function, lambda or functor taking an `Entity`.
+         * @param f The function.
+         */
+        template<typename Function>
+        void for_each(Function f) const
+        {
+            for (int j = 0; j < Words; j++)
+            {
+                unsigned int word = _mask[j];
+                if (word == 0xffffffff)
+                {
+                    for (Entity e = j * 32; e < j * 32 + 32; e++)
+                        f(e);
+                    continue;
+                }
+                while (word != 0)
+                {
+                    f(j * 32 + lowest(word));
+                    word &= word - 1;
+                }
+            }
+        }
+
     };
 }
 
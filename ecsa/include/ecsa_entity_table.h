@@ -1,515 +1,446 @@
 #ifndef ECSA_ENTITY_TABLE_H
 #define ECSA_ENTITY_TABLE_H
 
+#include <new>
+#include <utility>
+
 #include "ecsa.h"
 #include "bn_log.h"
 
 namespace ecsa
 {
     template<int Entities, int Components, int Systems>
-    class EntityTable
+    class EntityTable : public BasicTable<EntityTable<Entities, Components, Systems>, Entities, Components, Systems>
     {
-        EntityMask<Entities> _entities;
-        Array<Array<Component *, Entities>, Components> _table;
-
-        EntityMask<Components * Entities> _iwram_allocated;
-        Array<IArray *, Components> _iwram_components;
+        using Base = BasicTable<EntityTable<Entities, Components, Systems>, Entities, Components, Systems>;
 
-        Array<ISystem *, Systems> _systems;
 
-        public:
-
-        
         /**
-         * @brief Constructor.
+         * @brief Number of entities in each page of a column.
          * 
          */
-        EntityTable() : _systems(nullptr), _iwram_components(nullptr)
-        {
-            for (Entity e = 0; e < Entities; e++)
-            {
-                for (int c = 0; c < Components; c++)
-                    _table[c][e] = nullptr;
-            }
-
-        }
+        static constexpr int PageEntities = 32;
 
 
         /**
-         * @brief Create a new entity and return its Id.
+         * @brief Number of pages in each column.
          * 
-         * @return Entity 
          */
-        [[nodiscard]] Entity create()
-        {
-            return _entities.create();
-        }
+        static constexpr int Pages = Entities == 0 ? 1 : ((Entities - 1) / PageEntities + 1);
 
 
         /**
-         * @brief Subscribe an entity to all the relevant systems in the table.
+         * @brief The components of a column for a block of `PageEntities` consecutive entities.
+         * Pages are allocated on the heap the first time a component is added to one of their entities.
          * 
-         * @param e The Id of the entity to subscribe.
          */
-        void subscribe(Entity e)
+        struct Page
         {
-            for (int i = 0; i < Systems; i++)
-            {
-                ISystem * s = _systems[i];
-                if (s != nullptr && s->select(e))
-                    s->subscribe(e);
-            }
-        }
+            Component * components [ PageEntities ];
+            unsigned int pooled;
+        };
 
-        
-        /**
-         * @brief Remove an entity from the table, 
-         * and unsubscribe it from all the relevant systems.
-         * 
-         * @param e The Id of the entity.
-         */
-        void destroy(Entity e)
-        {
-            for (int c = 0; c < Components; c++)
-            {
-                delete _table[c][e];
-                _table[c][e] = nullptr;
-                _iwram_allocated.destroy(Entities * c + e);
-            }
-            for (int i = 0; i < Systems; i++)
-            {
-                ISystem * s = _systems[i];
-                if (s != nullptr && s->subscribed(e))
-                    s->unsubscribe(e);
-            }
-            _entities.destroy(e);
-        }
 
+        EntityMask<Entities> _entities;
+        Array<Array<Page *, Pages>, Components> _pages;
+        Array<Signature<Components>, Entities> _signatures;
 
-        /**
-         * @brief Destroy all the entities in the table.
-         * 
-         */
-        void clear()
-        {
-            for (Entity e = 0; e < Entities; e++)
-            {
-                if (_entities.contains(e))
-                    destroy(e);
-            }
-        }
+        Array<IArray *, Components> _iwram_components;
+
+        Array<Pool, Components> _pools;
+
+        Array<ISparseSet *, Components> _sparse_components;
 
 
         /**
-         * @brief Tells if the table contains a certain entity.
+         * @brief Returns the component of an entity (`nullptr` if it has no component in the column, or if the page is not allocated).
          * 
+         * @param c The Id of the component.
          * @param e The Id of the entity.
-         * @return true 
-         * @return false 
+         * @return Component* 
          */
-        [[nodiscard]] bool contains(Entity e)
+        [[nodiscard]] Component * find(int c, Entity e)
         {
-            return _entities.contains(e);
+            Page * page = _pages[c][e / PageEntities];
+            return page == nullptr ? nullptr : page->components[e % PageEntities];
         }
 
 
         /**
-         * @brief Add a component to an entity.
+         * @brief Store the component of an entity, allocating its page if needed.
          * 
-         * @tparam Id The Id of the component.
+         * @param c The Id of the component.
          * @param e The Id of the entity.
-         * @param c A pointer to the component object, created with `new`.
+         * @param component The component.
+         * @param pooled Tells if the component was constructed in the pool of the column.
          */
-        template<int Id>
-        void add(Entity e, Component * c)
+        void store(int c, Entity e, Component * component, bool pooled)
         {
-            assert(_table[Id][e] == nullptr && "ECSA ERROR: component already exists!");
-            _table[Id][e] = c;
+            Page *& page = _pages[c][e / PageEntities];
+            if (page == nullptr)
+                page = new Page();
+            page->components[e % PageEntities] = component;
+            if (pooled)
+                page->pooled |= 1u << (e % PageEntities);
         }
 
 
         /**
-         * @brief Add an IWRAM (stack-allocated) component.
+         * @brief Delete a component, giving its memory back to the column pool if it was emplaced.
          * 
-         * @tparam Type The type of the component.
-         * @tparam Id The Id of the component.
-         * @param e The entity to attach this component to.
-         * @param c The component to attach. (will be copied)
+         * @param c The Id of the component.
+         * @param e The Id of the entity.
          */
-        template<typename Type, int Id>
-        void add(Entity e, Type c)
+        void release(int c, Entity e)
         {
-            assert(_iwram_components[Id] != nullptr && "ECSA ERROR: IWRAM component not found!");
-            _iwram_allocated.add(Entities * Id + e);
-            (*((Array<Type, Entities> *) _iwram_components[Id]))[e] = c;
+            Page * page = _pages[c][e / PageEntities];
+            if (page == nullptr)
+                return;
+            int i = e % PageEntities;
+            Component * component = page->components[i];
+            if (component == nullptr)
+                return;
+            if ((page->pooled >> i) & 1)
+            {
+                component->~Component();
+                _pools[c].deallocate(component);
+                page->pooled &= ~(1u << i);
+            }
+            else
+                delete component;
+            page->components[i] = nullptr;
         }
 
+        public:
+
+        using Base::add;
+        using Base::get;
 
+        
         /**
-         * @brief Add a component array to the table for IWRAM components.
+         * @brief Constructor.
+         * Only the page pointers of the columns are initialized: the pages are allocated when components are added.
          * 
-         * @tparam Id The ID of the component.
-         * @param components_array A pointer to the component array.
          */
-        template<int Id>
-        void add(IArray * components_array)
+        EntityTable() : _pages(Array<Page *, Pages>(nullptr)), _iwram_components(nullptr), _sparse_components(nullptr)
         {
-            assert(_iwram_components[Id] == nullptr && "ECSA ERROR: IWRAM component already exists!");
-            _iwram_components[Id] = components_array;
+
         }
 
 
         /**
-         * @brief Returns a reference to an IWRAM-allocated array of components.
+         * @brief Create a new entity and return its Id.
          * 
-         * @tparam Type 
-         * @tparam Id 
-         * @return Array<Type, Entities>& 
+         * @return Entity 
          */
-        template<typename Type, int Id>
-        [[nodiscard]] Array<Type, Entities> & get()
+        [[nodiscard]] Entity create()
         {
-            assert(_iwram_components[Id] != nullptr && "ECSA ERROR: IWRAM component not found!");
-            return (Array<Type, Entities> &) *(_iwram_components[Id]);
+            return _entities.create();
         }
 
 
         /**
-         * @brief Get a reference to the component of an entity.
-         * Only EWRAM (heap) allocated components are available through this function.
+         * @brief Create a number of new entities, with contiguous Ids if possible.
+         * If the table is full, the bag only holds the entities that could be created.
          * 
-         * @tparam Type The type of the component.
-         * @tparam Id The Id of the component.
-         * @param e The Id of the entity.
-         * @return Type& 
+         * @tparam Size The maximum size of the returned entity bag.
+         * @param n The number of entities.
+         * @return EntityBag<Size, EntityIndex<Entities>> The Ids of the new entities.
          */
-        template<typename Type, int Id>
-        [[nodiscard]] Type & get(Entity e)
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, EntityIndex<Entities>> create(int n)
         {
-            assert(_table[Id][e] != nullptr && "ECSA ERROR: component not found!");
-            return (Type &) *(_table[Id][e]);
+            EntityBag<Size, EntityIndex<Entities>> entities;
+            _entities.create(n, entities);
+            return entities;
         }
 
 
         /**
-         * @brief Tells if an entity has a certain component.
+         * @brief Remove an entity from the table, 
+         * and unsubscribe it from all the relevant systems.
          * 
-         * @tparam Id The Id of the component.
          * @param e The Id of the entity.
-         * @return true 
-         * @return false
          */
-        template<int Id>
-        [[nodiscard]] bool has(Entity e)
+        void destroy(Entity e)
         {
-            return _iwram_allocated.contains(Entities * Id + e) || _table[Id][e] != nullptr;
+            for (int c = 0; c < Components; c++)
+            {
+                release(c, e);
+                if (_sparse_components[c] != nullptr)
+                    _sparse_components[c]->erase(e);
+            }
+            this->retire(e);
+            _signatures[e].clear();
+            _entities.destroy(e);
         }
 
 
         /**
-         * @brief Add a system to the table.
+         * @brief Destroy all the entities in the table.
+         * The components are deleted one column at a time (skipping the columns no entity owns),
+         * and the systems drop all their entities at once, so this costs about as much as the number of components.
+         * The pages of the columns are kept for the next entities.
          * 
-         * @tparam Id The Id to assign to the system.
-         * @param s A pointer to the system, created with `new`.
          */
-        template<int Id>
-        void add(ISystem * s)
+        void clear()
         {
-            assert(_systems[Id] == nullptr && "ECSA ERROR: system already exists!");
-            s->activate();
-            _systems[Id] = s;
+            Signature<Components> used;
+            _entities.for_each([this, &used](Entity e) { used |= _signatures[e]; });
+            this->reset(_entities);
+            for (int c = 0; c < Components; c++)
+            {
+                if (!used.contains(c))
+                    continue;
+                if (_sparse_components[c] != nullptr)
+                    _sparse_components[c]->clear();
+                _entities.for_each([this, c](Entity e) { release(c, e); });
+            }
+            _entities.for_each([this](Entity e) { _signatures[e].clear(); });
+            _entities.clear();
         }
 
 
         /**
-         * @brief Get a system by its Id.
+         * @brief Tells if the table contains a certain entity.
          * 
-         * @tparam Id The Id of the system.
-         * @return ISystem* 
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false 
          */
-        template<int Id>
-        [[nodiscard]] ISystem * get()
+        [[nodiscard]] bool contains(Entity e)
         {
-            assert(_systems[Id] != nullptr && "ECSA ERROR: system not found!");
-            return _systems[Id];
+            return _entities.contains(e);
         }
 
 
         /**
-         * @brief Activate a system. (Its `update` function will be executed when `EntityTable::update()` is called)
+         * @brief Returns the mask of the entities in the table, which can be iterated
+         * to visit them in increasing order without checking the empty slots.
          * 
-         * @tparam Id The Id of the system to activate.
+         * @return const EntityMask<Entities>& 
          */
-        template<int Id>
-        void activate()
+        [[nodiscard]] const EntityMask<Entities> & entities()
         {
-            ISystem * s = _systems[Id];
-            s->activate();
+            return _entities;
         }
 
 
         /**
-         * @brief Dectivate a system. (Its `update` function will not be executed when `EntityTable::update()` is called)
+         * @brief Add a component to an entity.
          * 
-         * @tparam Id The Id of the system to activate.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @param c A pointer to the component object, created with `new`.
          */
         template<int Id>
-        void deactivate()
+        void add(Entity e, Component * c)
         {
-            ISystem * s = _systems[Id];
-            s->deactivate();
+            assert(find(Id, e) == nullptr && "ECSA ERROR: component already exists!");
+            store(Id, e, c, false);
+            _signatures[e].add(Id);
+            this->refresh(e, Id);
         }
 
 
         /**
-         * @brief Activate all systems associated to the table. (Their `update` function will be executed when `EntityTable::update()` is called)
+         * @brief Construct a component in place, inside the memory pool of its column.
+         * The pool recycles the memory of destroyed components, so no heap allocation happens
+         * unless the pool runs out of free slots.
+         * All the components emplaced in a column should have the same type (or at least not be bigger than the first one).
          * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @tparam Args The types of the arguments passed to the component's constructor.
+         * @param e The Id of the entity.
+         * @param args The arguments passed to the component's constructor.
+         * @return Type& 
          */
-        void activate_all()
+        template<typename Type, int Id, typename... Args>
+        Type & emplace(Entity e, Args &&... args)
         {
-            for (int i = 0; i < Systems; i++)
-            {
-                ISystem * s = _systems[i];
-                if (s != nullptr)
-                    s->activate();
-            }
+            assert(find(Id, e) == nullptr && "ECSA ERROR: component already exists!");
+            Pool & pool = _pools[Id];
+            if (pool.slot_size() == 0)
+                pool.init(sizeof(Type), alignof(Type));
+            assert(pool.fits(sizeof(Type), alignof(Type)) && "ECSA ERROR: component does not fit in the pool of its column!");
+            Type * c = new (pool.allocate()) Type(std::forward<Args>(args)...);
+            assert((void *) static_cast<Component *>(c) == (void *) c && "ECSA ERROR: Component must be the first base of pooled components!");
+            store(Id, e, c, true);
+            _signatures[e].add(Id);
+            this->refresh(e, Id);
+            return *c;
         }
 
 
         /**
-         * @brief Deactivate all systems associated to the table. (Their `update` function will not be executed when `EntityTable::update()` is called)
+         * @brief Tells how many components are currently stored in the pool of a column.
          * 
+         * @tparam Id The Id of the component.
+         * @return int 
          */
-        void deactivate_all()
+        template<int Id>
+        [[nodiscard]] int pool_size()
         {
-            for (int i = 0; i < Systems; i++)
-            {
-                ISystem * s = _systems[i];
-                if (s != nullptr)
-                    s->deactivate();
-            }
+            return _pools[Id].size();
         }
 
 
         /**
-         * @brief Perform a query that returns the Ids of all the entities
-         * subscribed to a certain system.
+         * @brief Tells how many components the pool of a column can store before allocating a new slab.
          * 
-         * @tparam Size The maximum number of entities processed by the system.
-         * @tparam SystemId The Id of the system.
-         * @return EntityBag<Size> 
+         * @tparam Id The Id of the component.
+         * @return int 
          */
-        template<int Size, int SystemId>
-        [[nodiscard]] EntityBag<Size> query()
+        template<int Id>
+        [[nodiscard]] int pool_capacity()
         {
-            return ((System<Entities, Size> *) get<SystemId>())->subscribed();
+            return _pools[Id].capacity();
         }
 
 
         /**
-         * @brief Perform a query on the whole table, using a `bool` function for filtering.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * @brief Add an IWRAM (stack-allocated) component, or a component of a sparse column.
          * 
-         * @tparam Size The expected maximum number of entites the query will find.
-         * @param func A pointer to the function used as a fltering condition.
-         * @return EntityBag<Size> 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The entity to attach this component to.
+         * @param c The component to attach. (will be copied)
          */
-        template<int Size>
-        [[nodiscard]] EntityBag<Size> query(bool (* func) (EntityTable<Entities, Components, Systems> &, Entity))
+        template<typename Type, int Id>
+        void add(Entity e, Type c)
         {
-            EntityBag<Size> result;
-            for (Entity e = 0; e < Entities; e++)
+            if (_sparse_components[Id] != nullptr)
+                *((Type *) _sparse_components[Id]->insert(e)) = c;
+            else
             {
-                if (contains(e) && (*func)(*this, e))
-                    result.push_back(e);
+                assert(_iwram_components[Id] != nullptr && "ECSA ERROR: IWRAM component not found!");
+                (*((Array<Type, Entities> *) _iwram_components[Id]))[e] = c;
             }
-            return result;
-        }
-
-
-        /**
-         * @brief Perform an optimized query on the whole table.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
-         * 
-         * @tparam Size The maximum number of entites expected to be retrieved by the query.
-         * @param func A pointer to the function used for filtering.
-         * @return EntityBag<Size> 
-         */
-        template<int Size>
-        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (EntityTable<Entities, Components, Systems> &))
-        {
-            return (*func)(*this);
+            _signatures[e].add(Id);
+            this->refresh(e, Id);
         }
 
 
         /**
-         * @brief Perform a query on the whole table, using a `bool` function for filtering.
-         * Allows also to pass a parameter of any type for dynamic filtering.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * @brief Remove a component from an entity, and update its subscriptions to the systems that depend on it.
          * 
-         * @tparam Size The expected maximum number of entites the query will find.
-         * @tparam ParamType The type of the parameter used for filtering.
-         * @param func A pointer to the function used as a filtering condition.
-         * @param param A refernece to the parameter used for dynamic filtering.
-         * @return EntityBag<Size> 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
          */
-        template<int Size, typename ParamType>
-        [[nodiscard]] EntityBag<Size> query(bool (* func) (EntityTable<Entities, Components, Systems> &, Entity, ParamType &), ParamType & param)
+        template<int Id>
+        void remove(Entity e)
         {
-            EntityBag<Size> result;
-            for (Entity e = 0; e < Entities; e++)
-            {
-                if (contains(e) && (*func)(*this, e, param))
-                    result.push_back(e);
-            }
-            return result;
+            assert(has<Id>(e) && "ECSA ERROR: component not found!");
+            release(Id, e);
+            if (_sparse_components[Id] != nullptr)
+                _sparse_components[Id]->erase(e);
+            _signatures[e].destroy(Id);
+            this->refresh(e, Id);
         }
 
 
         /**
-         * @brief Perform an optimized query on the whole table.
-         * Allows also to pass a parameter of any type for dynamic filtering.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * @brief Add a component array to the table for IWRAM components.
          * 
-         * @tparam Size The maximum number of entites expected to be retrieved by the query.
-         * @tparam ParamType The type of the parameter used for filtering.
-         * @param func A pointer to the function used for filtering.
-         * @param param A refernece to the parameter used for dynamic filtering.
-         * @return EntityBag<Size> 
+         * @tparam Id The ID of the component.
+         * @param components_array A pointer to the component array.
          */
-        template<int Size, typename ParamType>
-        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (EntityTable<Entities, Components, Systems> &, ParamType &), ParamType & param)
+        template<int Id>
+        void add(IArray * components_array)
         {
-            return (*func)(*this, param);
+            assert(_iwram_components[Id] == nullptr && "ECSA ERROR: IWRAM component already exists!");
+            _iwram_components[Id] = components_array;
         }
 
 
         /**
-         * @brief Perform a query on the subset of entities processed by a certain system, 
-         * using a `bool` function for filtering.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * @brief Add a sparse set to the table, to be used as storage for a sparse column.
          * 
-         * @tparam Size The maximum number of entites processed by the system.
-         * @tparam SystemId The Id of the system.
-         * @param func A pointer to the function used as a filtering condition.
-         * @return EntityBag<Size> 
+         * @tparam Id The ID of the component.
+         * @param components_set A pointer to the sparse set.
          */
-        template<int Size, int SystemId>
-        [[nodiscard]] EntityBag<Size> query(bool (* func) (EntityTable<Entities, Components, Systems> &, Entity))
+        template<int Id>
+        void add(ISparseSet * components_set)
         {
-            EntityBag<Size> result;
-            EntityBag<Size> ids = ((System<Entities, Size> *) get<SystemId>())->subscribed();
-            for (Entity e : ids)
-            {
-                if ((*func)(*this, e))
-                    result.push_back(e);
-            }
-            return result;
+            assert(_sparse_components[Id] == nullptr && "ECSA ERROR: sparse component already exists!");
+            _sparse_components[Id] = components_set;
         }
 
 
         /**
-         * @brief Perform an optimized query on the subset of entities processed by a certain system.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * @brief Returns a reference to the sparse set used as storage for a sparse column.
          * 
-         * @tparam Size The maximum number of entites processed by the system.
-         * @tparam SystemId The Id of the system.
-         * @param func A pointer to the function used as a filtering condition.
-         * @return EntityBag<Size> 
-         */
-        template<int Size, int SystemId>
-        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (EntityTable<Entities, Components, Systems> &, EntityBag<Size> &))
-        {
-            EntityBag<Size> ids = ((System<Entities, Size> *) get<SystemId>())->subscribed();
-            return (*func)(*this, ids);
-        }
-
-        
-        /**
-         * @brief Perform a query on the subset of entities processed by a certain system, 
-         * using a `bool` function for filtering.
-         * Allows also to pass a parameter of any type for dynamic filtering.
-         * Returns an EntityBag with the ids of the Ids of the entities that satisfy the filtering condition.
-         * 
-         * @tparam Size The maximum number of entites processed by the system.
-         * @tparam SystemId The Id of the system.
-         * @tparam ParamType The type of the parameter used for filtering.
-         * @param func A pointer to the function used as a filtering condition.
-         * @param param A refernece to the parameter used for dynamic filtering.
-         * @return EntityBag<Size> 
+         * @tparam Type The type of the components.
+         * @tparam MaxSize The capacity of the sparse set.
+         * @tparam Id The Id of the component.
+         * @return SparseSet<Type, Entities, MaxSize>& 
          */
-        template<int Size, int SystemId, typename ParamType>
-        [[nodiscard]] EntityBag<Size> query(bool (* func) (EntityTable<Entities, Components, Systems> &, Entity, ParamType &), ParamType & param)
+        template<typename Type, int MaxSize, int Id>
+        [[nodiscard]] SparseSet<Type, Entities, MaxSize> & get()
         {
-            EntityBag<Size> result;
-            EntityBag<Size> ids = ((System<Entities, Size> *) get<SystemId>())->subscribed();
-            for (Entity e : ids)
-            {
-                if ((*func)(*this, e, param))
-                    result.push_back(e);
-            }
-            return result;
+            assert(_sparse_components[Id] != nullptr && "ECSA ERROR: sparse component not found!");
+            return (SparseSet<Type, Entities, MaxSize> &) *(_sparse_components[Id]);
         }
 
 
         /**
-         * @brief Perform an optimized query on the subset of entities processed by a certain system.
-         * Allows also to pass a parameter of any type for dynamic filtering.
-         * Returns an EntityBag with the Ids of the entities that satisfy the filtering condition.
+         * @brief Returns a reference to an IWRAM-allocated array of components.
          * 
-         * @tparam Size The maximum number of entites processed by the system.
-         * @tparam SystemId The Id of the system.
-         * @tparam ParamType The type of the parameter used for filtering.
-         * @param func A pointer to the function used for filtering.
-         * @param param A refernece to the parameter used for filtering.
-         * @return EntityBag<Size> 
+         * @tparam Type 
+         * @tparam Id 
+         * @return Array<Type, Entities>& 
          */
-        template<int Size, int SystemId, typename ParamType>
-        [[nodiscard]] EntityBag<Size> query(EntityBag<Size> (* func) (EntityTable<Entities, Components, Systems> &, EntityBag<Size> &, ParamType &), ParamType & param)
+        template<typename Type, int Id>
+        [[nodiscard]] Array<Type, Entities> & get()
         {
-            EntityBag<Size> ids = ((System<Entities, Size> *) get<SystemId>())->subscribed();
-            return (*func)(*this, ids, param);
+            assert(_iwram_components[Id] != nullptr && "ECSA ERROR: IWRAM component not found!");
+            return (Array<Type, Entities> &) *(_iwram_components[Id]);
         }
 
 
         /**
-         * @brief Initialize all the systems in the table.
+         * @brief Get a reference to the component of an entity.
+         * Only EWRAM (heap) allocated components are available through this function.
          * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return Type& 
          */
-        void init()
+        template<typename Type, int Id>
+        [[nodiscard]] Type & get(Entity e)
         {
-            for (int i = 0; i < Systems; i++)
-            {
-                ISystem * s = _systems[i];
-                if (s != nullptr)
-                    s->init();
-            }
+            Component * c = find(Id, e);
+            assert(c != nullptr && "ECSA ERROR: component not found!");
+            return (Type &) *c;
         }
 
 
         /**
-         * @brief Update all the (active) systems in the table.
+         * @brief Tells if an entity has a certain component.
          * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false
          */
-        void update()
+        template<int Id>
+        [[nodiscard]] bool has(Entity e)
         {
-            for (int i = 0; i < Systems; i++)
-            {
-                ISystem * s = _systems[i];
-                if (s != nullptr && s->active())
-                    s->update();
-            }
+            return _signatures[e].contains(Id);
         }
 
 
         /**
-         * @brief Returns the maximum number of entities the table can contain.
+         * @brief Returns the signature of an entity (the set of components it owns).
          * 
-         * @return constexpr int 
+         * @param e The Id of the entity.
+         * @return Signature<Components>& 
          */
-        [[nodiscard]] constexpr int capacity()
+        [[nodiscard]] Signature<Components> & signature(Entity e)
         {
-            return Entities;
+            return _signatures[e];
         }
 
 
@@ -521,11 +452,16 @@ namespace ecsa
         {
             for (int c = 0; c < Components; c++)
             {
-                for (int e = 0; e < Entities; e++)
-                    delete _table[c][e];
+                for (int p = 0; p < Pages; p++)
+                {
+                    if (_pages[c][p] == nullptr)
+                        continue;
+                    // a page covers the entities of one word of the mask: only the live ones can own a component
+                    for (unsigned int word = _entities.word(p); word != 0; word &= word - 1)
+                        release(c, p * PageEntities + __builtin_ctz(word));
+                    delete _pages[c][p];
+                }
             }
-            for (int s = 0; s < Systems; s++)
-                delete _systems[s];
         }
 
 
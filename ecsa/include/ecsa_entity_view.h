@@ -0,0 +1,131 @@
+#ifndef ECSA_ENTITY_VIEW_H
+#define ECSA_ENTITY_VIEW_H
+
+#include <cassert>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    template<typename Index>
+    class BasicEntityView
+    {
+        /**
+         * @brief Pointer to the first entity ID.
+         * 
+         */
+        const Index * _ids;
+
+
+        /**
+         * @brief The number of entity IDs.
+         * 
+         */
+        int _size;
+
+
+        public:
+
+
+        /**
+         * @brief Constructor. (empty view)
+         * 
+         */
+        BasicEntityView() : _ids(nullptr), _size(0)
+        {
+
+        }
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param ids Pointer to the first entity ID.
+         * @param size The number of entity IDs.
+         */
+        BasicEntityView(const Index * ids, int size) : _ids(ids), _size(size)
+        {
+
+        }
+
+
+        /**
+         * @brief Tells if the view is empty.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool empty() const
+        {
+            return _size == 0;
+        }
+
+
+        /**
+         * @brief Tells the number of entity IDs in the view.
+         * 
+         * @return int 
+         */
+        [[nodiscard]] int size() const
+        {
+            return _size;
+        }
+
+
+        /**
+         * @brief Beginning of view (iterator).
+         * 
+         * @return const Index* 
+         */
+        [[nodiscard]] const Index * begin() const
+        {
+            return _ids;
+        }
+
+
+        /**
+         * @brief End of view (iterator).
+         * 
+         * @return const Index* 
+         */
+        [[nodiscard]] const Index * end() const
+        {
+            return _ids + _size;
+        }
+
+
+        /**
+         * @brief Returns an entity ID of the view at a certain index.
+         * 
+         * @param i The index.
+         * @return Entity 
+         */
+        [[nodiscard]] Entity operator[](int i) const
+        {
+            assert(i < _size && "ECSA ERROR: index of EntityView out of range!");
+            return _ids[i];
+        }
+
+
+        /**
+         * @brief Copies the entity IDs in the view to an entity bag.
+         * 
+         * @tparam Size The maximum size of the entity bag.
+         * @return EntityBag<Size, Index> 
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, Index> collect() const
+        {
+            assert(_size <= Size && "ECSA ERROR: entity bag is too small!");
+            EntityBag<Size, Index> result;
+            for (int i = 0; i < _size; i++)
+                result.push_back(_ids[i]);
+            return result;
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,199 @@
+#ifndef ECSA_EXECUTOR_H
+#define ECSA_EXECUTOR_H
+
+#include <cassert>
+#include <type_traits>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    class Executor
+    {
+        public:
+
+
+        /**
+         * @brief A task of a batch: a function taking a context, the index of the task in the batch,
+         * and the index of the worker running it (from 0 to `workers() - 1`).
+         * 
+         */
+        using Task = void (*)(void * context, int index, int worker);
+
+
+        /**
+         * @brief Tells the number of workers that can run tasks at the same time (the calling thread included).
+         * 
+         * @return int
+         */
+        [[nodiscard]] virtual int workers() = 0;
+
+
+        /**
+         * @brief Run a batch of tasks, and return when all of them are done.
+         * The tasks can run in any order, and at the same time on different workers.
+         * 
+         * @param task The function of the tasks.
+         * @param context The context passed to each task.
+         * @param count The number of tasks.
+         */
+        virtual void run(Task task, void * context, int count) = 0;
+
+
+        virtual ~Executor() = default;
+    };
+
+
+    /**
+     * @brief A copy of a value for each worker of an executor, used as scratch memory by the tasks running at the same time
+     * (for example, to accumulate partial results that are then reduced into one). Each copy is aligned to its own
+     * cache line on the platforms that have one, so workers do not slow each other down when writing to their copies.
+     * 
+     * @tparam Type The type of the value.
+     * @tparam Workers The maximum number of workers.
+     */
+    template<typename Type, int Workers>
+    class PerWorker
+    {
+        struct alignas(64) Slot
+        {
+            Type value;
+        };
+
+
+        /**
+         * @brief The copies of the value.
+         * 
+         */
+        Slot _slots [ Workers ];
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param value The initial value of every copy.
+         */
+        PerWorker(const Type & value = Type())
+        {
+            reset(value);
+        }
+
+
+        /**
+         * @brief Set every copy to a value.
+         * 
+         * @param value The value.
+         */
+        void reset(const Type & value)
+        {
+            for (int i = 0; i < Workers; i++)
+                _slots[i].value = value;
+        }
+
+
+        /**
+         * @brief Returns the copy of a worker.
+         * 
+         * @param worker The index of the worker.
+         * @return Type& 
+         */
+        [[nodiscard]] Type & operator[](int worker)
+        {
+            assert(worker >= 0 && worker < Workers && "ECSA ERROR: too many workers for PerWorker!");
+            return _slots[worker].value;
+        }
+
+
+        /**
+         * @brief Combine all the copies into one value.
+         * 
+         * @tparam Function The type of the function: a function, lambda or functor taking two values and returning their combination.
+         * @param initial The value to start from.
+         * @param combine The function.
+         * @return Type 
+         */
+        template<typename Function>
+        [[nodiscard]] Type reduce(Type initial, Function combine) const
+        {
+            for (int i = 0; i < Workers; i++)
+                initial = combine(initial, _slots[i].value);
+            return initial;
+        }
+
+    };
+
+
+    /**
+     * @brief A batch of chunks of entities, passed to an executor by `parallel_for_each`.
+     * 
+     * @tparam Index The type the Ids of the entities are stored as.
+     * @tparam Function The type of the function called on each entity.
+     */
+    template<typename Index, typename Function>
+    struct ForEachChunks
+    {
+        BasicEntityView<Index> entities;
+        int chunk_size;
+        Function * f;
+
+
+        /**
+         * @brief Call the function on the entities of a chunk (a task of the executor).
+         * 
+         * @param context The batch.
+         * @param index The index of the chunk.
+         * @param worker The worker processing the chunk.
+         */
+        static void run(void * context, int index, int worker)
+        {
+            ForEachChunks * chunks = static_cast<ForEachChunks *>(context);
+            int first = index * chunks->chunk_size;
+            int last = first + chunks->chunk_size;
+            if (last > chunks->entities.size())
+                last = chunks->entities.size();
+            for (int i = first; i < last; i++)
+            {
+                if constexpr (std::is_invocable_v<Function &, Entity, int>)
+                    (*chunks->f)(Entity(chunks->entities[i]), worker);
+                else
+                    (*chunks->f)(Entity(chunks->entities[i]));
+            }
+        }
+    };
+
+
+    /**
+     * @brief Call a function on each entity of a view, splitting the view in chunks that the workers of an executor
+     * process at the same time. The function must only access data that no other entity of the view accesses
+     * (for example, the components of its own entity), or data of its worker (see `PerWorker`).
+     * Without an executor, the entities are processed in order on the calling thread, as worker 0.
+     * 
+     * @tparam Index The type the Ids of the view are stored as.
+     * @tparam Function The type of the function: a function, lambda or functor taking `(Entity)` or `(Entity, int worker)`.
+     * @param executor The executor (or `nullptr`).
+     * @param entities The entities.
+     * @param chunk_size The number of entities in each chunk.
+     * @param f The function.
+     */
+    template<typename Index, typename Function>
+    void parallel_for_each(Executor * executor, BasicEntityView<Index> entities, int chunk_size, Function f)
+    {
+        assert(chunk_size > 0 && "ECSA ERROR: invalid chunk size!");
+        ForEachChunks<Index, Function> chunks { entities, chunk_size, &f };
+        int count = (entities.size() + chunk_size - 1) / chunk_size;
+        if (executor == nullptr)
+        {
+            for (int i = 0; i < count; i++)
+                ForEachChunks<Index, Function>::run(&chunks, i, 0);
+            return;
+        }
+        executor->run(&ForEachChunks<Index, Function>::run, &chunks, count);
+    }
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,597 @@
+#ifndef ECSA_INDEX_H
+#define ECSA_INDEX_H
+
+#include <cassert>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    /**
+     * @brief The type of the field a member pointer refers to.
+     * 
+     */
+    template<typename Member>
+    struct FieldType;
+
+    template<typename Type, typename Key>
+    struct FieldType<Key Type::*>
+    {
+        using type = Key;
+    };
+
+
+    /**
+     * @brief The hash function used by `HashIndex`: a conversion to `unsigned int`, which works for integers and enums.
+     * Specialize it for other key types.
+     * 
+     * @tparam Key The type of the key.
+     */
+    template<typename Key>
+    struct IndexHash
+    {
+        [[nodiscard]] unsigned int operator()(const Key & key) const
+        {
+            return static_cast<unsigned int>(key);
+        }
+    };
+
+
+    class IIndex
+    {
+        /**
+         * @brief The Id of the indexed component.
+         * 
+         */
+        int _component;
+
+
+        public:
+
+
+        /**
+         * @brief The next index on the same component, in the list kept by the table.
+         * 
+         */
+        IIndex * next;
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param component The Id of the indexed component.
+         */
+        IIndex(int component) : _component(component), next(nullptr)
+        {
+
+        }
+
+
+        /**
+         * @brief Returns the Id of the indexed component.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int component()
+        {
+            return _component;
+        }
+
+
+        /**
+         * @brief Called by the table when the component of an entity is added or marked as changed.
+         * The entity is only re-indexed on the next lookup, so the field can still be written after `get_mut`.
+         * 
+         * @param e The Id of the entity.
+         */
+        virtual void touch(Entity e) = 0;
+
+
+        /**
+         * @brief Called by the table when the component of an entity is removed (or the entity is destroyed).
+         * 
+         * @param e The Id of the entity.
+         */
+        virtual void erase(Entity e) = 0;
+
+
+        /**
+         * @brief Called by the table when all the entities are destroyed at once.
+         * 
+         */
+        virtual void clear() = 0;
+
+
+        virtual ~IIndex() = default;
+    };
+
+
+    template<typename Table, typename Type, int Id, auto Field>
+    class OrderedIndex : public IIndex
+    {
+        static constexpr int Entities = Table::capacity();
+
+        using Key = typename FieldType<decltype(Field)>::type;
+        using Index = EntityIndex<Entities>;
+
+
+        /**
+         * @brief The table owning the indexed components.
+         * 
+         */
+        Table & _table;
+
+
+        /**
+         * @brief The indexed entities and their keys, sorted by key.
+         * 
+         */
+        Array<Key, Entities> _keys;
+        Array<Index, Entities> _entities;
+        int _size;
+
+
+        /**
+         * @brief The key each indexed entity was last sorted with.
+         * 
+         */
+        Array<Key, Entities> _indexed_keys;
+        EntityMask<Entities> _indexed;
+
+
+        /**
+         * @brief The entities to re-index before the next lookup.
+         * 
+         */
+        EntityMask<Entities> _dirty;
+        EntityBag<Entities, EntityIndex<Entities>> _pending;
+
+
+        /**
+         * @brief Returns the position of the first key not less than a certain key.
+         * 
+         * @param key The key.
+         * @return int
+         */
+        [[nodiscard]] int lower_bound(const Key & key)
+        {
+            int first = 0;
+            int last = _size;
+            while (first < last)
+            {
+                int middle = (first + last) / 2;
+                if (_keys[middle] < key)
+                    first = middle + 1;
+                else
+                    last = middle;
+            }
+            return first;
+        }
+
+
+        /**
+         * @brief Returns the position of the first key greater than a certain key.
+         * 
+         * @param key The key.
+         * @return int
+         */
+        [[nodiscard]] int upper_bound(const Key & key)
+        {
+            int first = 0;
+            int last = _size;
+            while (first < last)
+            {
+                int middle = (first + last) / 2;
+                if (key < _keys[middle])
+                    last = middle;
+                else
+                    first = middle + 1;
+            }
+            return first;
+        }
+
+
+        /**
+         * @brief Insert an entity in the sorted arrays.
+         * 
+         * @param e The Id of the entity.
+         * @param key The key of the entity.
+         */
+        void insert(Entity e, const Key & key)
+        {
+            int position = upper_bound(key);
+            for (int i = _size; i > position; i--)
+            {
+                _keys[i] = _keys[i - 1];
+                _entities[i] = _entities[i - 1];
+            }
+            _keys[position] = key;
+            _entities[position] = static_cast<Index>(e);
+            _size++;
+            _indexed_keys[e] = key;
+            _indexed.add(e);
+        }
+
+
+        /**
+         * @brief Remove an indexed entity from the sorted arrays.
+         * 
+         * @param e The Id of the entity.
+         */
+        void remove(Entity e)
+        {
+            int position = lower_bound(_indexed_keys[e]);
+            while (_entities[position] != e)
+                position++;
+            _size--;
+            for (int i = position; i < _size; i++)
+            {
+                _keys[i] = _keys[i + 1];
+                _entities[i] = _entities[i + 1];
+            }
+            _indexed.destroy(e);
+        }
+
+
+        /**
+         * @brief Re-index the entities whose component was added or changed since the last lookup.
+         * 
+         */
+        void update()
+        {
+            for (Entity e : _pending)
+            {
+                _dirty.destroy(e);
+                if (!_table.contains(e) || !_table.template has<Id>(e))
+                    continue;
+                const Key & key = _table.template get<Type, Id>(e).*Field;
+                if (_indexed.contains(e))
+                {
+                    if (!(_indexed_keys[e] < key) && !(key < _indexed_keys[e]))
+                        continue;
+                    remove(e);
+                }
+                insert(e, key);
+            }
+            _pending.clear();
+        }
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param table The table owning the indexed components.
+         */
+        OrderedIndex(Table & table) : IIndex(Id), _table(table), _size(0)
+        {
+
+        }
+
+
+        void touch(Entity e) override
+        {
+            if (_dirty.contains(e))
+                return;
+            _dirty.add(e);
+            _pending.push_back(e);
+        }
+
+
+        void erase(Entity e) override
+        {
+            if (_indexed.contains(e))
+                remove(e);
+        }
+
+
+        void clear() override
+        {
+            _size = 0;
+            _indexed.clear();
+            _dirty.clear();
+            _pending.clear();
+        }
+
+
+        /**
+         * @brief Returns the entities whose key is between `min` and `max` (both included), sorted by key.
+         * The view is invalidated by the next change to the index.
+         * 
+         * @param min The smallest key.
+         * @param max The largest key.
+         * @return BasicEntityView<EntityIndex<Table::capacity()>>
+         */
+        [[nodiscard]] BasicEntityView<Index> range(const Key & min, const Key & max)
+        {
+            update();
+            int first = lower_bound(min);
+            int last = upper_bound(max);
+            if (last <= first)
+                return BasicEntityView<Index>();
+            return BasicEntityView<Index>(&_entities[first], last - first);
+        }
+
+
+        /**
+         * @brief Returns the entities whose key is equal to a certain key.
+         * The view is invalidated by the next change to the index.
+         * 
+         * @param key The key.
+         * @return BasicEntityView<EntityIndex<Table::capacity()>>
+         */
+        [[nodiscard]] BasicEntityView<Index> equal(const Key & key)
+        {
+            return range(key, key);
+        }
+
+
+        /**
+         * @brief Returns all the indexed entities, sorted by key.
+         * The view is invalidated by the next change to the index.
+         * 
+         * @return BasicEntityView<EntityIndex<Table::capacity()>>
+         */
+        [[nodiscard]] BasicEntityView<Index> all()
+        {
+            update();
+            return BasicEntityView<Index>(&_entities[0], _size);
+        }
+
+    };
+
+
+    template<typename Table, typename Type, int Id, auto Field, int Buckets, typename Hash>
+    class HashIndex : public IIndex
+    {
+        static constexpr int Entities = Table::capacity();
+
+        using Key = typename FieldType<decltype(Field)>::type;
+
+
+        /**
+         * @brief The table owning the indexed components.
+         * 
+         */
+        Table & _table;
+
+
+        /**
+         * @brief The first entity of each bucket (-1 if it is empty), and the links between the entities of a bucket.
+         * The links are stored as `EntityIndex`, so the ends of a list link an entity to itself.
+         * 
+         */
+        Array<Entity, Buckets> _heads;
+        Array<EntityIndex<Entities>, Entities> _next;
+        Array<EntityIndex<Entities>, Entities> _previous;
+
+
+        /**
+         * @brief The key each indexed entity was last hashed with.
+         * 
+         */
+        Array<Key, Entities> _indexed_keys;
+        EntityMask<Entities> _indexed;
+
+
+        /**
+         * @brief The entities to re-index before the next lookup.
+         * 
+         */
+        EntityMask<Entities> _dirty;
+        EntityBag<Entities, EntityIndex<Entities>> _pending;
+
+
+        /**
+         * @brief Returns the bucket of a key.
+         * 
+         * @param key The key.
+         * @return int
+         */
+        [[nodiscard]] static int bucket(const Key & key)
+        {
+            return static_cast<int>(Hash()(key) % Buckets);
+        }
+
+
+        /**
+         * @brief Returns the entity after another one in its bucket.
+         * 
+         * @param e The Id of the entity.
+         * @return Entity The Id of the next entity, or -1 if `e` is the last one.
+         */
+        [[nodiscard]] Entity next(Entity e)
+        {
+            return _next[e] == e ? -1 : Entity(_next[e]);
+        }
+
+
+        /**
+         * @brief Link an entity at the front of the bucket of its key.
+         * 
+         * @param e The Id of the entity.
+         * @param key The key of the entity.
+         */
+        void insert(Entity e, const Key & key)
+        {
+            int b = bucket(key);
+            Entity head = _heads[b];
+            _next[e] = head >= 0 ? head : e;
+            _previous[e] = e;
+            if (head >= 0)
+                _previous[head] = e;
+            _heads[b] = e;
+            _indexed_keys[e] = key;
+            _indexed.add(e);
+        }
+
+
+        /**
+         * @brief Unlink an indexed entity from its bucket.
+         * 
+         * @param e The Id of the entity.
+         */
+        void remove(Entity e)
+        {
+            Entity previous = _previous[e];
+            Entity next = _next[e];
+            if (previous != e)
+                _next[previous] = next != e ? next : previous;
+            else
+                _heads[bucket(_indexed_keys[e])] = next != e ? next : -1;
+            if (next != e)
+                _previous[next] = previous != e ? previous : next;
+            _indexed.destroy(e);
+        }
+
+
+        /**
+         * @brief Re-index the entities whose component was added or changed since the last lookup.
+         * 
+         */
+        void update()
+        {
+            for (Entity e : _pending)
+            {
+                _dirty.destroy(e);
+                if (!_table.contains(e) || !_table.template has<Id>(e))
+                    continue;
+                const Key & key = _table.template get<Type, Id>(e).*Field;
+                if (_indexed.contains(e))
+                {
+                    if (_indexed_keys[e] == key)
+                        continue;
+                    remove(e);
+                }
+                insert(e, key);
+            }
+            _pending.clear();
+        }
+
+
+        public:
+
+
+        /**
+         * @brief The entities with a certain key, returned by `equal`. Can be iterated, or passed to `from` to build a query.
+         * 
+         */
+        class Matches
+        {
+            HashIndex * _index;
+            Key _key;
+
+            public:
+
+            class iterator
+            {
+                HashIndex * _index;
+                const Key * _key;
+                Entity _e;
+
+                void skip()
+                {
+                    while (_e >= 0 && !(_index->_indexed_keys[_e] == *_key))
+                        _e = _index->next(_e);
+                }
+
+                public:
+
+                iterator(HashIndex * index, const Key * key, Entity e) : _index(index), _key(key), _e(e)
+                {
+                    skip();
+                }
+
+                [[nodiscard]] Entity operator*() const
+                {
+                    return _e;
+                }
+
+                iterator & operator++()
+                {
+                    _e = _index->next(_e);
+                    skip();
+                    return *this;
+                }
+
+                [[nodiscard]] bool operator!=(const iterator & other) const
+                {
+                    return _e != other._e;
+                }
+            };
+
+            Matches(HashIndex * index, const Key & key) : _index(index), _key(key)
+            {
+
+            }
+
+            [[nodiscard]] iterator begin() const
+            {
+                return iterator(_index, &_key, _index->_heads[bucket(_key)]);
+            }
+
+            [[nodiscard]] iterator end() const
+            {
+                return iterator(_index, &_key, -1);
+            }
+        };
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param table The table owning the indexed components.
+         */
+        HashIndex(Table & table) : IIndex(Id), _table(table), _heads(-1)
+        {
+
+        }
+
+
+        void touch(Entity e) override
+        {
+            if (_dirty.contains(e))
+                return;
+            _dirty.add(e);
+            _pending.push_back(e);
+        }
+
+
+        void erase(Entity e) override
+        {
+            if (_indexed.contains(e))
+                remove(e);
+        }
+
+
+        void clear() override
+        {
+            for (int b = 0; b < Buckets; b++)
+                _heads[b] = -1;
+            _indexed.clear();
+            _dirty.clear();
+            _pending.clear();
+        }
+
+
+        /**
+         * @brief Returns the entities whose key is equal to a certain key.
+         * The result is invalidated by the next change to the index.
+         * 
+         * @param key The key.
+         * @return Matches
+         */
+        [[nodiscard]] Matches equal(const Key & key)
+        {
+            update();
+            return Matches(this, key);
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
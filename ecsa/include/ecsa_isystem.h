@@ -15,6 +15,77 @@ namespace ecsa
         bool _active;
 
 
+        protected:
+
+
+        /**
+         * @brief The Ids of the components an entity must own to be subscribed automatically.
+         * 
+         */
+        const int * _required = nullptr;
+        int _required_count = 0;
+
+
+        /**
+         * @brief The Ids of the components an entity must not own to be subscribed automatically.
+         * 
+         */
+        const int * _excluded = nullptr;
+        int _excluded_count = 0;
+
+
+        /**
+         * @brief Tells if `select` is also called on the entities that own the declared components.
+         * 
+         */
+        bool _filtered = false;
+
+
+        /**
+         * @brief Tells if the subscribed entities must be re-evaluated before being read.
+         * 
+         */
+        bool _stale = false;
+
+
+        /**
+         * @brief The Ids of the components the system reads and writes in `update`.
+         * 
+         */
+        const int * _reads = nullptr;
+        int _reads_count = 0;
+        const int * _writes = nullptr;
+        int _writes_count = 0;
+
+
+        /**
+         * @brief Tells if the system declared the components it reads and writes.
+         * 
+         */
+        bool _access = false;
+
+
+        /**
+         * @brief Tells if the subscribed entities are being processed in chunks by the workers of an executor (see `parallel_for_each`).
+         * 
+         */
+        bool _chunking = false;
+
+
+        /**
+         * @brief The executor of the table owning the system, used by `parallel_for_each` (`nullptr` if there is none).
+         * 
+         */
+        Executor * _executor = nullptr;
+
+
+        /**
+         * @brief The maximum number of entities of the table the system was declared for (see `table_entities`).
+         * 
+         */
+        int _table_entities = 0;
+
+
         public:
 
 
@@ -49,6 +120,149 @@ namespace ecsa
         }
 
 
+        /**
+         * @brief Tells if the system declares the components of the entities it processes.
+         * If it does, entities are subscribed to it automatically, and `select` is not used.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool declarative()
+        {
+            return _required_count > 0 || _excluded_count > 0;
+        }
+
+
+        /**
+         * @brief Tells if `select` is also used to filter the entities that own the components declared by the system.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool filtered()
+        {
+            return _filtered;
+        }
+
+
+        /**
+         * @brief Tells if the subscribed entities are out of date, and must be re-evaluated by the table before being read.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool stale()
+        {
+            return _stale;
+        }
+
+
+        /**
+         * @brief Marks the subscribed entities as out of date, for example because something `select` depends on changed.
+         * 
+         */
+        void invalidate()
+        {
+            _stale = true;
+        }
+
+
+        /**
+         * @brief Marks the subscribed entities as up to date.
+         * 
+         */
+        void validate()
+        {
+            _stale = false;
+        }
+
+
+        /**
+         * @brief Build the signatures of the components declared by the system.
+         * 
+         * @tparam Components The maximum number of components of the table owning the system.
+         * @param required The signature of the components an entity must own.
+         * @param excluded The signature of the components an entity must not own.
+         */
+        template<int Components>
+        void signatures(Signature<Components> & required, Signature<Components> & excluded)
+        {
+            required.clear();
+            excluded.clear();
+            for (int i = 0; i < _required_count; i++)
+                required.add(_required[i]);
+            for (int i = 0; i < _excluded_count; i++)
+                excluded.add(_excluded[i]);
+        }
+
+
+        /**
+         * @brief Tells if the system declared the components it reads and writes in `update`.
+         * If it did, a table with an `Executor` can run it at the same time as the other systems it does not conflict with.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool concurrent()
+        {
+            return _access;
+        }
+
+
+        /**
+         * @brief Tells the maximum number of entities of the table the system was declared for.
+         * The subscribed entities are stored as `EntityIndex` of that number, so the table checks that it matches its own.
+         * 
+         * @return int 
+         */
+        [[nodiscard]] int table_entities()
+        {
+            return _table_entities;
+        }
+
+
+        /**
+         * @brief Tells if the subscribed entities are being processed in chunks by the workers of an executor.
+         * 
+         * @return true 
+         * @return false 
+         */
+        [[nodiscard]] bool chunking()
+        {
+            return _chunking;
+        }
+
+
+        /**
+         * @brief Set the executor used by `parallel_for_each`. Called by the table owning the system.
+         * 
+         * @param executor The executor (or `nullptr`).
+         */
+        void executor(Executor * executor)
+        {
+            _executor = executor;
+        }
+
+
+        /**
+         * @brief Build the signatures of the components the system reads and writes.
+         * 
+         * @tparam Components The maximum number of components of the table owning the system.
+         * @param reads The signature of the components the system reads.
+         * @param writes The signature of the components the system writes.
+         */
+        template<int Components>
+        void access(Signature<Components> & reads, Signature<Components> & writes)
+        {
+            reads.clear();
+            writes.clear();
+            for (int i = 0; i < _reads_count; i++)
+                reads.add(_reads[i]);
+            for (int i = 0; i < _writes_count; i++)
+                writes.add(_writes[i]);
+        }
+
+
         /**
          * @brief Used to filter entities based on some condition.
          * This function is ran every time an entity is subscribed to an entity table.
@@ -82,10 +296,64 @@ namespace ecsa
 
         }
 
-        
-        virtual void subscribe(Entity e);
-        virtual void unsubscribe(Entity e);
-        virtual bool subscribed(Entity e);
+
+        /**
+         * @brief Subscribe an entity to the system.
+         * 
+         * @param e The Id of the entity.
+         */
+        virtual void subscribe(Entity e) = 0;
+
+
+        /**
+         * @brief Unsubscribe an entity from the system.
+         * 
+         * @param e The Id of the entity.
+         */
+        virtual void unsubscribe(Entity e) = 0;
+
+
+        /**
+         * @brief Unsubscribe a batch of entities from the system, in a single pass over the subscribed entities.
+         * 
+         * @param mask The words of an `EntityMask<TableEntities>` of the entities (see `EntityMask::words`).
+         */
+        virtual void unsubscribe(const unsigned int * mask) = 0;
+
+
+        /**
+         * @brief Unsubscribe all the entities from the system at once.
+         * 
+         */
+        virtual void clear() = 0;
+
+
+        /**
+         * @brief Tells whether an entity is subscribed to the system or not.
+         * 
+         * @param e The Id of the entity.
+         * @return true 
+         * @return false 
+         */
+        virtual bool subscribed(Entity e) = 0;
+
+
+        /**
+         * @brief Returns a pointer to the Ids of the subscribed entities, stored as `EntityIndex<TableEntities>`.
+         * The table reads them through a view of the matching type.
+         * 
+         * @return const void* 
+         */
+        virtual const void * subscribed_ids() = 0;
+
+
+        /**
+         * @brief Tells the number of subscribed entities.
+         * 
+         * @return int 
+         */
+        virtual int subscribed_count() = 0;
+
 
         virtual ~ISystem() = default;
     };  
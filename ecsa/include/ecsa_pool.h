@@ -0,0 +1,233 @@
+#ifndef ECSA_POOL_H
+#define ECSA_POOL_H
+
+#include <cassert>
+#include <cstddef>
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    class Pool
+    {
+        /**
+         * @brief Header of each slab. The slots of the slab follow the header in memory.
+         * 
+         */
+        struct Slab
+        {
+            Slab * next;
+        };
+
+
+        /**
+         * @brief Size in bytes of the slab header, padded so that the first slot is suitably aligned.
+         * 
+         */
+        static constexpr int _header_size = (sizeof(Slab) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+
+        /**
+         * @brief List of all the slabs allocated by the pool.
+         * 
+         */
+        Slab * _slabs;
+
+
+        /**
+         * @brief List of free slots. Each free slot stores a pointer to the next one.
+         * 
+         */
+        void * _free;
+
+
+        /**
+         * @brief Size in bytes of each slot (0 if the pool was not initialized yet).
+         * 
+         */
+        int _slot_size;
+
+
+        /**
+         * @brief Alignment of each slot.
+         * 
+         */
+        int _slot_align;
+
+
+        /**
+         * @brief Number of slots currently in use.
+         * 
+         */
+        int _size;
+
+
+        /**
+         * @brief Total number of slots allocated (used or free).
+         * 
+         */
+        int _capacity;
+
+
+        /**
+         * @brief Allocate a new slab and push all its slots to the free list.
+         * 
+         */
+        void grow()
+        {
+            unsigned char * memory = new unsigned char[_header_size + SlabSlots * _slot_size];
+            Slab * slab = (Slab *) memory;
+            slab->next = _slabs;
+            _slabs = slab;
+
+            unsigned char * slots = memory + _header_size;
+            for (int i = SlabSlots - 1; i >= 0; i--)
+            {
+                void * slot = slots + i * _slot_size;
+                *((void **) slot) = _free;
+                _free = slot;
+            }
+            _capacity += SlabSlots;
+        }
+
+
+        public:
+
+
+        /**
+         * @brief Number of slots allocated at once every time the pool runs out of free slots.
+         * 
+         */
+        static constexpr int SlabSlots = 32;
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        Pool() : _slabs(nullptr), _free(nullptr), _slot_size(0), _slot_align(0), _size(0), _capacity(0)
+        {
+
+        }
+
+
+        Pool(const Pool &) = delete;
+        Pool & operator=(const Pool &) = delete;
+
+
+        /**
+         * @brief Set the size and alignment of the slots. Must be called before the first allocation.
+         * 
+         * @param size The size in bytes of the objects stored in the pool.
+         * @param align The alignment of the objects stored in the pool.
+         */
+        void init(int size, int align)
+        {
+            assert(_capacity == 0 && "ECSA ERROR: pool is already in use!");
+            assert(align <= (int) alignof(std::max_align_t) && "ECSA ERROR: over-aligned types are not supported by pools!");
+            if (size < (int) sizeof(void *))
+                size = sizeof(void *);
+            if (align < (int) alignof(void *))
+                align = alignof(void *);
+            _slot_size = (size + align - 1) / align * align;
+            _slot_align = align;
+        }
+
+
+        /**
+         * @brief Tells if the pool can store an object with a certain size and alignment.
+         * 
+         * @param size The size in bytes of the object.
+         * @param align The alignment of the object.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool fits(int size, int align)
+        {
+            return size <= _slot_size && _slot_align % align == 0;
+        }
+
+
+        /**
+         * @brief Get a free slot, allocating a new slab only if no recycled slot is available.
+         * 
+         * @return void*
+         */
+        [[nodiscard]] void * allocate()
+        {
+            assert(_slot_size > 0 && "ECSA ERROR: pool was not initialized!");
+            if (_free == nullptr)
+                grow();
+            void * slot = _free;
+            _free = *((void **) slot);
+            _size++;
+            return slot;
+        }
+
+
+        /**
+         * @brief Give a slot back to the pool. The object in the slot must have already been destroyed.
+         * 
+         * @param slot A pointer to the slot, obtained with `allocate()`.
+         */
+        void deallocate(void * slot)
+        {
+            assert(_size > 0 && "ECSA ERROR: pool is empty!");
+            *((void **) slot) = _free;
+            _free = slot;
+            _size--;
+        }
+
+
+        /**
+         * @brief Tells the number of slots currently in use.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int size()
+        {
+            return _size;
+        }
+
+
+        /**
+         * @brief Tells the total number of slots allocated by the pool (used or free).
+         * 
+         * @return int
+         */
+        [[nodiscard]] int capacity()
+        {
+            return _capacity;
+        }
+
+
+        /**
+         * @brief Tells the size in bytes of each slot (0 if the pool was not initialized yet).
+         * 
+         * @return int
+         */
+        [[nodiscard]] int slot_size()
+        {
+            return _slot_size;
+        }
+
+
+        /**
+         * @brief Destructor. Releases all the slabs; objects still in the pool are not destroyed.
+         * 
+         */
+        ~Pool()
+        {
+            while (_slabs != nullptr)
+            {
+                Slab * next = _slabs->next;
+                delete [] (unsigned char *) _slabs;
+                _slabs = next;
+            }
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
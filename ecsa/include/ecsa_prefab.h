@@ -0,0 +1,198 @@
+#ifndef ECSA_PREFAB_H
+#define ECSA_PREFAB_H
+
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    template<typename Type, int Id>
+    struct With
+    {
+
+    };
+
+
+    template<typename Table, typename... Types, int... Ids>
+    class Prefab<Table, With<Types, Ids>...>
+    {
+        /**
+         * @brief The table the entities are created in.
+         * 
+         */
+        Table & _table;
+
+
+        /**
+         * @brief The initial values of the components, copied to each new entity.
+         * 
+         */
+        std::tuple<Types...> _values;
+
+
+        /**
+         * @brief The systems the entities of the prefab belong to, found when the prefab is created
+         * (and found again by the table only if systems are added to it afterwards).
+         * 
+         */
+        typename Table::Subscribers _subscribers;
+
+
+        /**
+         * @brief Copy the initial value of a component to some entities, one column at a time.
+         * 
+         * @tparam Type The type of the component.
+         * @tparam Id The Id of the component.
+         * @param entities The entities.
+         * @param value The initial value of the component.
+         */
+        template<typename Type, int Id>
+        void place(typename Table::View entities, const Type & value)
+        {
+            for (Entity e : entities)
+                _table.template emplace<Type, Id>(e, value);
+        }
+
+
+        /**
+         * @brief Call the initialization function of the prefab on an entity.
+         * The function can take either the table and the entity, or only the entity.
+         * 
+         * @tparam Function The type of the function.
+         * @param init The function.
+         * @param e The Id of the entity.
+         */
+        template<typename Function>
+        void call(Function & init, Entity e)
+        {
+            if constexpr (std::is_invocable_v<Function &, Table &, Entity>)
+                init(_table, e);
+            else
+                init(e);
+        }
+
+
+        /**
+         * @brief Add the components of the prefab to some new entities, call a function on each of them,
+         * and subscribe them to the relevant systems.
+         * 
+         * @tparam Function The type of the function.
+         * @param entities The new entities.
+         * @param init The function.
+         */
+        template<typename Function>
+        void spawn(typename Table::View entities, Function & init)
+        {
+            _table.spawn(entities, _subscribers, [this, &init](typename Table::View entities) {
+                std::apply([this, entities](const Types &... values) { (place<Types, Ids>(entities, values), ...); }, _values);
+                for (Entity e : entities)
+                    call(init, e);
+            });
+        }
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param table The table the entities are created in.
+         * @param values The initial values of the components, in the same order as the `With` arguments.
+         */
+        Prefab(Table & table, const Types &... values) : _table(table), _values(values...),
+            _subscribers(table.template subscribers<Ids...>())
+        {
+
+        }
+
+
+        /**
+         * @brief Returns a reference to the initial value of a component, which can be changed before creating more entities.
+         * 
+         * @tparam Index The position of the component in the `With` arguments.
+         * @return auto&
+         */
+        template<int Index>
+        [[nodiscard]] auto & value()
+        {
+            return std::get<Index>(_values);
+        }
+
+
+        /**
+         * @brief Create a new entity with a copy of the components of the prefab.
+         * 
+         * @return Entity
+         */
+        Entity instantiate()
+        {
+            return instantiate([](Entity) { });
+        }
+
+
+        /**
+         * @brief Create a new entity with a copy of the components of the prefab, and call a function on it
+         * before it is subscribed to the systems (for example, to create its sprite).
+         * The function can change the components of the entity, but not add or remove any.
+         * 
+         * @tparam Function The type of the function: a function, lambda or functor taking `(Table &, Entity)` or `(Entity)`.
+         * @param init The function.
+         * @return Entity
+         */
+        template<typename Function>
+        Entity instantiate(Function init)
+        {
+            Entity e = _table.create();
+            assert(e >= 0 && "ECSA ERROR: the table is full!");
+            EntityIndex<Table::capacity()> id = e;
+            spawn(typename Table::View(&id, 1), init);
+            return e;
+        }
+
+
+        /**
+         * @brief Create a number of new entities (with contiguous Ids if possible) with a copy of the components of the prefab.
+         * The components are copied one column at a time, and the entities are subscribed all at once to the systems they belong to.
+         * Like the entities passed to `subscribe`, they are also checked by the systems that implement `select`.
+         * 
+         * @tparam Size The maximum size of the returned entity bag.
+         * @param n The number of entities.
+         * @return EntityBag<Size, EntityIndex<Table::capacity()>> The Ids of the new entities.
+         */
+        template<int Size>
+        EntityBag<Size, EntityIndex<Table::capacity()>> instantiate(int n)
+        {
+            return instantiate<Size>(n, [](Entity) { });
+        }
+
+
+        /**
+         * @brief Create a number of new entities (with contiguous Ids if possible) with a copy of the components of the prefab,
+         * and call a function on each of them before they are subscribed to the systems.
+         * The function can change the components of the entities, but not add or remove any.
+         * 
+         * @tparam Size The maximum size of the returned entity bag.
+         * @tparam Function The type of the function: a function, lambda or functor taking `(Table &, Entity)` or `(Entity)`.
+         * @param n The number of entities.
+         * @param init The function.
+         * @return EntityBag<Size, EntityIndex<Table::capacity()>> The Ids of the new entities.
+         */
+        template<int Size, typename Function>
+        EntityBag<Size, EntityIndex<Table::capacity()>> instantiate(int n, Function init)
+        {
+            EntityBag<Size, EntityIndex<Table::capacity()>> entities = _table.template create<Size>(n);
+            assert(entities.size() == n && "ECSA ERROR: the table is full!");
+            spawn(typename Table::View(entities.begin(), entities.size()), init);
+            return entities;
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,299 @@
+#ifndef ECSA_QUERY_H
+#define ECSA_QUERY_H
+
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    /**
+     * @brief The entities of a query built with `from<SystemId>()` or `from(view)`: the ones in a view.
+     * 
+     * @tparam Index The type the Ids of the view are stored as.
+     */
+    template<typename Index>
+    class ViewSource
+    {
+        BasicEntityView<Index> _view;
+
+        public:
+
+        ViewSource(BasicEntityView<Index> view) : _view(view)
+        {
+
+        }
+
+        [[nodiscard]] const Index * begin() const
+        {
+            return _view.begin();
+        }
+
+        [[nodiscard]] const Index * end() const
+        {
+            return _view.end();
+        }
+    };
+
+
+    /**
+     * @brief The entities of a query built with `from()`: all the entities in the table,
+     * visited through the mask of the table so that the empty slots are skipped a word at a time.
+     * `count` goes through `for_each`, which visits the full words with a plain loop.
+     * 
+     */
+    template<int Entities>
+    class TableSource
+    {
+        const EntityMask<Entities> * _entities;
+
+        public:
+
+        using iterator = typename EntityMask<Entities>::iterator;
+
+        TableSource(const EntityMask<Entities> & entities) : _entities(&entities)
+        {
+
+        }
+
+        [[nodiscard]] iterator begin() const
+        {
+            return _entities->begin();
+        }
+
+        [[nodiscard]] iterator end() const
+        {
+            return _entities->end();
+        }
+
+        template<typename Function>
+        void for_each(Function f) const
+        {
+            _entities->for_each(f);
+        }
+    };
+
+
+    /**
+     * @brief Tells if a source of a query has a `for_each`, used instead of its iterators when the query visits all its entities.
+     * 
+     */
+    template<typename Source, typename = void>
+    struct HasForEach : std::false_type
+    {
+
+    };
+
+
+    template<typename Source>
+    struct HasForEach<Source, std::void_t<decltype(std::declval<const Source &>().for_each(std::declval<void (*)(Entity)>()))>> : std::true_type
+    {
+
+    };
+
+
+    template<typename Table, typename Source, typename... Filters>
+    class Query
+    {
+        /**
+         * @brief The table being queried.
+         * 
+         */
+        Table & _table;
+
+
+        /**
+         * @brief The entities the query runs on.
+         * 
+         */
+        Source _source;
+
+
+        /**
+         * @brief The filters, tested in the order they were added.
+         * 
+         */
+        std::tuple<Filters...> _filters;
+
+
+        /**
+         * @brief Test a filter on an entity. Filters can take either the table and the entity, or only the entity.
+         * 
+         * @tparam Filter The type of the filter.
+         * @param filter The filter.
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        template<typename Filter>
+        [[nodiscard]] bool test(Filter & filter, Entity e)
+        {
+            if constexpr (std::is_invocable_v<Filter &, Table &, Entity>)
+                return filter(_table, e);
+            else
+                return filter(e);
+        }
+
+
+        /**
+         * @brief Tells if an entity of the source satisfies all the filters.
+         * 
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool accepts(Entity e)
+        {
+            return std::apply([this, e](Filters &... filters) { return (test(filters, e) && ...); }, _filters);
+        }
+
+
+        /**
+         * @brief The type of the iterators of the source.
+         * 
+         */
+        using SourceIterator = decltype(std::declval<const Source &>().begin());
+
+
+        public:
+
+
+        class iterator
+        {
+            Query * _query;
+            SourceIterator _it;
+            SourceIterator _end;
+
+            void skip()
+            {
+                while (_it != _end && !_query->accepts(*_it))
+                    ++_it;
+            }
+
+            public:
+
+            iterator(Query * query, SourceIterator it, SourceIterator end) : _query(query), _it(it), _end(end)
+            {
+                skip();
+            }
+
+            [[nodiscard]] Entity operator*() const
+            {
+                return *_it;
+            }
+
+            iterator & operator++()
+            {
+                ++_it;
+                skip();
+                return *this;
+            }
+
+            [[nodiscard]] bool operator!=(const iterator & other) const
+            {
+                return _it != other._it;
+            }
+        };
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param table The table being queried.
+         * @param source The entities the query runs on.
+         * @param filters The filters.
+         */
+        Query(Table & table, Source source, std::tuple<Filters...> filters) : _table(table), _source(source), _filters(filters)
+        {
+
+        }
+
+
+        /**
+         * @brief Returns a new query which also filters the entities with a predicate.
+         * Nothing is evaluated until the query is iterated: all the filters are then tested in a single pass.
+         * 
+         * @tparam Filter The type of the predicate: a function, lambda or functor taking `(Table &, Entity)` or `(Entity)` and returning `bool`.
+         * @param filter The predicate.
+         * @return Query<Table, Source, Filters..., Filter>
+         */
+        template<typename Filter>
+        [[nodiscard]] Query<Table, Source, Filters..., Filter> where(Filter filter)
+        {
+            return Query<Table, Source, Filters..., Filter>(_table, _source, std::tuple_cat(_filters, std::make_tuple(filter)));
+        }
+
+
+        /**
+         * @brief Beginning of query results (iterator).
+         * 
+         * @return iterator
+         */
+        [[nodiscard]] iterator begin()
+        {
+            return iterator(this, _source.begin(), _source.end());
+        }
+
+
+        /**
+         * @brief End of query results (iterator).
+         * 
+         * @return iterator
+         */
+        [[nodiscard]] iterator end()
+        {
+            return iterator(this, _source.end(), _source.end());
+        }
+
+
+        /**
+         * @brief Counts the entities satisfying the query.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int count()
+        {
+            int result = 0;
+            if constexpr (HasForEach<Source>::value)
+            {
+                _source.for_each([this, &result](Entity e) {
+                    if (accepts(e))
+                        result++;
+                });
+            }
+            else
+            {
+                for (Entity e : _source)
+                {
+                    if (accepts(e))
+                        result++;
+                }
+            }
+            return result;
+        }
+
+
+        /**
+         * @brief Copies the Ids of the entities satisfying the query to an entity bag.
+         * 
+         * @tparam Size The maximum size of the entity bag.
+         * @return EntityBag<Size, EntityIndex<Table::capacity()>>
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, EntityIndex<Table::capacity()>> collect()
+        {
+            EntityBag<Size, EntityIndex<Table::capacity()>> result;
+            for (Entity e : *this)
+                result.push_back(e);
+            return result;
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,192 @@
+#ifndef ECSA_SIGNATURE_H
+#define ECSA_SIGNATURE_H
+
+#include <cassert>
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    template<int Components>
+    class Signature
+    {
+        /**
+         * @brief Number of 32-bit words in the mask.
+         * 
+         */
+        static constexpr int Words = Components == 0 ? 1 : ((Components - 1) / 32 + 1);
+
+
+        /**
+         * @brief The component mask.
+         * 
+         */
+        unsigned int _mask [ Words ] = {};
+
+
+        public:
+
+
+        /**
+         * @brief Constructor. (empty signature)
+         * 
+         */
+        constexpr Signature()
+        {
+
+        }
+
+
+        /**
+         * @brief Returns a signature containing a set of components.
+         * 
+         * @tparam Ids The Ids of the components.
+         * @return Signature 
+         */
+        template<int... Ids>
+        [[nodiscard]] static constexpr Signature of()
+        {
+            Signature signature;
+            (signature.add(Ids), ...);
+            return signature;
+        }
+
+
+        /**
+         * @brief Marks a component as present.
+         * 
+         * @param c The Id of the component.
+         */
+        constexpr void add(int c)
+        {
+            assert(c < Components && "ECSA ERROR: component index is out of range!");
+            _mask[c >> 5] |= (1u << (c & 31));
+        }
+
+
+        /**
+         * @brief Marks a component as absent.
+         * 
+         * @param c The Id of the component.
+         */
+        void destroy(int c)
+        {
+            assert(c < Components && "ECSA ERROR: component index is out of range!");
+            _mask[c >> 5] &= ~(1u << (c & 31));
+        }
+
+
+        /**
+         * @brief Tells if a component is present in the signature.
+         * 
+         * @param c The Id of the component.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] constexpr bool contains(int c) const
+        {
+            assert(c < Components && "ECSA ERROR: component index is out of range!");
+            return ((_mask[c >> 5] >> (c & 31)) & 1) == 1;
+        }
+
+
+        /**
+         * @brief Tells if all the components of another signature are present in this one.
+         * 
+         * @param other The other signature.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains_all(const Signature & other) const
+        {
+            for (int i = 0; i < Words; i++)
+            {
+                if ((_mask[i] & other._mask[i]) != other._mask[i])
+                    return false;
+            }
+            return true;
+        }
+
+
+        /**
+         * @brief Tells if at least one of the components of another signature is present in this one.
+         * 
+         * @param other The other signature.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains_any(const Signature & other) const
+        {
+            for (int i = 0; i < Words; i++)
+            {
+                if ((_mask[i] & other._mask[i]) != 0)
+                    return true;
+            }
+            return false;
+        }
+
+
+        /**
+         * @brief Tells if the signature contains no components.
+         * 
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool empty() const
+        {
+            for (int i = 0; i < Words; i++)
+            {
+                if (_mask[i] != 0)
+                    return false;
+            }
+            return true;
+        }
+
+
+        /**
+         * @brief Adds all the components of another signature to the signature.
+         * 
+         * @param other The other signature.
+         * @return Signature&
+         */
+        Signature & operator|=(const Signature & other)
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] |= other._mask[i];
+            return *this;
+        }
+
+
+        /**
+         * @brief Removes all the components from the signature.
+         * 
+         */
+        void clear()
+        {
+            for (int i = 0; i < Words; i++)
+                _mask[i] = 0;
+        }
+
+
+        /**
+         * @brief Tells if two signatures contain exactly the same components.
+         * 
+         * @param other The other signature.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool operator==(const Signature & other) const
+        {
+            for (int i = 0; i < Words; i++)
+            {
+                if (_mask[i] != other._mask[i])
+                    return false;
+            }
+            return true;
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,232 @@
+#ifndef ECSA_SPARSE_SET_H
+#define ECSA_SPARSE_SET_H
+
+#include <cassert>
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    /**
+     * @brief Base class for SparseSet type.
+     * 
+     */
+    class ISparseSet
+    {
+        public:
+
+
+        /**
+         * @brief Tells if an entity owns a component in the set.
+         * 
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        virtual bool contains(Entity e) = 0;
+
+
+        /**
+         * @brief Get a pointer to the component of an entity, adding the entity to the set if needed.
+         * 
+         * @param e The Id of the entity.
+         * @return void*
+         */
+        virtual void * insert(Entity e) = 0;
+
+
+        /**
+         * @brief Remove the component of an entity from the set (if present).
+         * 
+         * @param e The Id of the entity.
+         */
+        virtual void erase(Entity e) = 0;
+
+
+        /**
+         * @brief Remove all the components from the set.
+         * 
+         */
+        virtual void clear() = 0;
+
+
+        virtual ~ISparseSet() = default;
+    };
+
+
+    template<typename Type, int Entities, int MaxSize>
+    class SparseSet : public ISparseSet
+    {
+        /**
+         * @brief Maps each entity Id to the index of its component in the dense array.
+         * 
+         */
+        Array<EntityIndex<MaxSize>, Entities> _sparse;
+
+
+        /**
+         * @brief The Ids of the entities owning a component, in the same order as the dense array.
+         * 
+         */
+        EntityBag<MaxSize, EntityIndex<Entities>> _entities;
+
+
+        /**
+         * @brief Packed array of components.
+         * 
+         */
+        Array<Type, MaxSize> _dense;
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        SparseSet() : _sparse(0)
+        {
+
+        }
+
+
+        /**
+         * @brief Tells if an entity owns a component in the set.
+         * 
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains(Entity e) override
+        {
+            int i = _sparse[e];
+            return i < _entities.size() && _entities[i] == e;
+        }
+
+
+        /**
+         * @brief Get a pointer to the component of an entity, adding the entity to the set if needed.
+         * 
+         * @param e The Id of the entity.
+         * @return void*
+         */
+        [[nodiscard]] void * insert(Entity e) override
+        {
+            if (!contains(e))
+            {
+                _sparse[e] = _entities.size();
+                _entities.push_back(e);
+            }
+            return &_dense[_sparse[e]];
+        }
+
+
+        /**
+         * @brief Add a component to the set. (will be copied)
+         * 
+         * @param e The Id of the entity.
+         * @param c The component.
+         */
+        void add(Entity e, Type c)
+        {
+            *((Type *) insert(e)) = c;
+        }
+
+
+        /**
+         * @brief Remove the component of an entity from the set (if present).
+         * The last component of the dense array is moved into the freed slot.
+         * 
+         * @param e The Id of the entity.
+         */
+        void erase(Entity e) override
+        {
+            if (!contains(e))
+                return;
+            int i = _sparse[e];
+            int last = _entities.size() - 1;
+            if (i != last)
+            {
+                _dense[i] = _dense[last];
+                _sparse[_entities.back()] = i;
+            }
+            _dense[last] = Type();
+            _entities.erase(i);
+        }
+
+
+        /**
+         * @brief Remove all the components from the set.
+         * 
+         */
+        void clear() override
+        {
+            for (int i = 0; i < _entities.size(); i++)
+                _dense[i] = Type();
+            _entities.clear();
+        }
+
+
+        /**
+         * @brief Returns a reference to the component of an entity.
+         * 
+         * @param e The Id of the entity.
+         * @return Type&
+         */
+        [[nodiscard]] Type & operator[](Entity e)
+        {
+            assert(contains(e) && "ECSA ERROR: component not found!");
+            return _dense[_sparse[e]];
+        }
+
+
+        /**
+         * @brief Returns a reference to the Ids of the entities in the set.
+         * The Id at index `i` is the owner of the component at index `i` of the dense array.
+         * 
+         * @return EntityBag<MaxSize, EntityIndex<Entities>>&
+         */
+        [[nodiscard]] EntityBag<MaxSize, EntityIndex<Entities>> & entities()
+        {
+            return _entities;
+        }
+
+
+        /**
+         * @brief Tells the number of components in the set.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int size()
+        {
+            return _entities.size();
+        }
+
+
+        /**
+         * @brief Beginning of the dense array of components (iterator).
+         * 
+         * @return Type*
+         */
+        [[nodiscard]] Type * begin()
+        {
+            return &_dense[0];
+        }
+
+
+        /**
+         * @brief End of the dense array of components (iterator).
+         * 
+         * @return Type*
+         */
+        [[nodiscard]] Type * end()
+        {
+            return begin() + _entities.size();
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
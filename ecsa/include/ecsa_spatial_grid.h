@@ -0,0 +1,357 @@
+#ifndef ECSA_SPATIAL_GRID_H
+#define ECSA_SPATIAL_GRID_H
+
+#include <cassert>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    /**
+     * @brief Converts a coordinate to an integer, to find the cell of the grid it belongs to.
+     * The default is a conversion to `int`: specialize it for other types (such as fixed point numbers).
+     * 
+     * @tparam Key The type of the coordinate.
+     */
+    template<typename Key>
+    struct GridCoordinate
+    {
+        [[nodiscard]] int operator()(const Key & value) const
+        {
+            return static_cast<int>(value);
+        }
+    };
+
+
+    template<typename Table, typename Type, int Id, auto X, auto Y, int Columns, int Rows>
+    class SpatialGrid
+    {
+        static constexpr int Entities = Table::capacity();
+        static constexpr int Cells = Columns * Rows;
+
+        using Key = typename FieldType<decltype(X)>::type;
+        using Index = EntityIndex<Entities>;
+
+
+        /**
+         * @brief The table owning the position components.
+         * 
+         */
+        Table & _table;
+
+
+        /**
+         * @brief The coordinates of the top-left corner of the grid, and the size of its cells.
+         * 
+         */
+        int _left;
+        int _top;
+        int _cell_size;
+
+
+        /**
+         * @brief The position in `_entities` of the first entity of each cell (the entities of a cell are contiguous,
+         * and the cells are stored row by row).
+         * 
+         */
+        Array<int, Cells + 1> _starts;
+
+
+        /**
+         * @brief The entities in the grid, sorted by cell, and a copy of their coordinates.
+         * 
+         */
+        Array<Index, Entities> _entities;
+        Array<Key, Entities> _xs;
+        Array<Key, Entities> _ys;
+        int _size;
+
+
+        /**
+         * @brief The cell of each entity passed to `rebuild`, in the order they were passed.
+         * 
+         */
+        Array<int, Entities> _cells;
+
+
+        /**
+         * @brief Returns the column of a coordinate, clamped to the grid.
+         * 
+         * @param x The coordinate.
+         * @return int
+         */
+        [[nodiscard]] int column(const Key & x)
+        {
+            int c = (GridCoordinate<Key>()(x) - _left) / _cell_size;
+            return c < 0 ? 0 : (c >= Columns ? Columns - 1 : c);
+        }
+
+
+        /**
+         * @brief Returns the row of a coordinate, clamped to the grid.
+         * 
+         * @param y The coordinate.
+         * @return int
+         */
+        [[nodiscard]] int row(const Key & y)
+        {
+            int r = (GridCoordinate<Key>()(y) - _top) / _cell_size;
+            return r < 0 ? 0 : (r >= Rows ? Rows - 1 : r);
+        }
+
+
+        /**
+         * @brief Returns the position component of an entity.
+         * 
+         * @param e The Id of the entity.
+         * @return Type&
+         */
+        [[nodiscard]] Type & position(Entity e)
+        {
+            return _table.template get<Type, Id>(e);
+        }
+
+
+        /**
+         * @brief Call a function on the pairs made of an entity of the grid and the following ones in a range,
+         * whose distance is not greater than a certain distance.
+         * 
+         * @param i The position of the entity in the grid.
+         * @param first The position of the first entity of the range.
+         * @param last The position after the last entity of the range.
+         * @param squared The squared distance.
+         * @param f The function.
+         */
+        template<typename Function>
+        void compare(int i, int first, int last, const Key & squared, Function & f)
+        {
+            for (int j = first; j < last; j++)
+            {
+                Key dx = _xs[j] - _xs[i];
+                Key dy = _ys[j] - _ys[i];
+                if (!(squared < dx * dx + dy * dy))
+                    f(Entity(_entities[i]), Entity(_entities[j]));
+            }
+        }
+
+
+        /**
+         * @brief Sort some entities by cell: count the entities of each cell, then copy each entity and its coordinates
+         * to the range of its cell.
+         * 
+         * @tparam Visit The type of the function visiting the entities: a lambda taking a function, and calling it
+         * on each entity, in the same order every time.
+         * @param visit The function visiting the entities.
+         */
+        template<typename Visit>
+        void sort(Visit visit)
+        {
+            _size = 0;
+            for (int c = 0; c <= Cells; c++)
+                _starts[c] = 0;
+            visit([this](Entity e) {
+                Type & p = position(e);
+                _cells[_size] = row(p.*Y) * Columns + column(p.*X);
+                _starts[_cells[_size] + 1]++;
+                _size++;
+            });
+            for (int c = 0; c < Cells; c++)
+                _starts[c + 1] += _starts[c];
+            int i = 0;
+            visit([this, &i](Entity e) {
+                Type & p = position(e);
+                int j = _starts[_cells[i++]]++;
+                _entities[j] = static_cast<Index>(e);
+                _xs[j] = p.*X;
+                _ys[j] = p.*Y;
+            });
+            for (int c = Cells; c > 0; c--)
+                _starts[c] = _starts[c - 1];
+            _starts[0] = 0;
+        }
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param table The table owning the position components.
+         * @param left The x coordinate of the left side of the grid.
+         * @param top The y coordinate of the top side of the grid.
+         * @param cell_size The width and height of the cells.
+         */
+        SpatialGrid(Table & table, int left, int top, int cell_size) :
+            _table(table), _left(left), _top(top), _cell_size(cell_size), _starts(0), _size(0)
+        {
+            assert(cell_size > 0 && "ECSA ERROR: invalid cell size!");
+        }
+
+
+        /**
+         * @brief Put some entities in the grid, replacing the previous ones.
+         * Their positions are read once and copied, so the grid must be rebuilt after they move
+         * (usually once per frame, at the end of the movement system).
+         * 
+         * @tparam EntitiesIndex The type the Ids of the view are stored as.
+         * @param entities The entities, which must own the position component.
+         */
+        template<typename EntitiesIndex>
+        void rebuild(BasicEntityView<EntitiesIndex> entities)
+        {
+            sort([entities](auto f) {
+                for (Entity e : entities)
+                    f(e);
+            });
+        }
+
+
+        /**
+         * @brief Put all the entities of the table that own the position component in the grid, replacing the previous ones.
+         * The entities are visited through the mask of the table, twice, without being copied.
+         * 
+         */
+        void rebuild()
+        {
+            sort([this](auto f) {
+                _table.entities().for_each([this, &f](Entity e) {
+                    if (_table.template has<Id>(e))
+                        f(e);
+                });
+            });
+        }
+
+
+        /**
+         * @brief Returns the number of entities in the grid.
+         * 
+         * @return int
+         */
+        [[nodiscard]] int size()
+        {
+            return _size;
+        }
+
+
+        /**
+         * @brief Returns the entities in a cell of the grid.
+         * 
+         * @param column The column of the cell.
+         * @param row The row of the cell.
+         * @return BasicEntityView<EntityIndex<Table::capacity()>>
+         */
+        [[nodiscard]] BasicEntityView<Index> cell(int column, int row)
+        {
+            assert(column >= 0 && column < Columns && row >= 0 && row < Rows && "ECSA ERROR: cell out of range!");
+            int c = row * Columns + column;
+            return BasicEntityView<Index>(&_entities[0] + _starts[c], _starts[c + 1] - _starts[c]);
+        }
+
+
+        /**
+         * @brief Returns the entities inside a box (borders included).
+         * Only the cells overlapping the box are checked.
+         * 
+         * @tparam Size The maximum size of the entity bag.
+         * @param min_x The left side of the box.
+         * @param min_y The top side of the box.
+         * @param max_x The right side of the box.
+         * @param max_y The bottom side of the box.
+         * @return EntityBag<Size, Index>
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, Index> query_box(const Key & min_x, const Key & min_y, const Key & max_x, const Key & max_y)
+        {
+            EntityBag<Size, Index> result;
+            int first_column = column(min_x);
+            int last_column = column(max_x);
+            for (int r = row(min_y), last_row = row(max_y); r <= last_row; r++)
+            {
+                // the cells of a row are contiguous
+                int last = _starts[r * Columns + last_column + 1];
+                for (int i = _starts[r * Columns + first_column]; i < last; i++)
+                {
+                    if (!(_xs[i] < min_x) && !(max_x < _xs[i]) && !(_ys[i] < min_y) && !(max_y < _ys[i]))
+                        result.push_back(_entities[i]);
+                }
+            }
+            return result;
+        }
+
+
+        /**
+         * @brief Returns the entities whose distance from a point is not greater than a certain radius.
+         * Only the cells overlapping the bounding box of the circle are checked.
+         * 
+         * @tparam Size The maximum size of the entity bag.
+         * @param x The x coordinate of the point.
+         * @param y The y coordinate of the point.
+         * @param radius The radius.
+         * @return EntityBag<Size, Index>
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, Index> query_radius(const Key & x, const Key & y, const Key & radius)
+        {
+            EntityBag<Size, Index> result;
+            Key squared = radius * radius;
+            int first_column = column(x - radius);
+            int last_column = column(x + radius);
+            for (int r = row(y - radius), last_row = row(y + radius); r <= last_row; r++)
+            {
+                int last = _starts[r * Columns + last_column + 1];
+                for (int i = _starts[r * Columns + first_column]; i < last; i++)
+                {
+                    Key dx = _xs[i] - x;
+                    Key dy = _ys[i] - y;
+                    if (!(squared < dx * dx + dy * dy))
+                        result.push_back(_entities[i]);
+                }
+            }
+            return result;
+        }
+
+
+        /**
+         * @brief Call a function on each pair of entities whose distance is not greater than a certain distance,
+         * which must not be greater than the size of the cells. Each pair is reported once, and only the entities
+         * in the same cell or in neighbouring cells are compared.
+         * 
+         * @tparam Function The type of the function: a function, lambda or functor taking `(Entity, Entity)`.
+         * @param distance The distance.
+         * @param f The function.
+         */
+        template<typename Function>
+        void pairs(const Key & distance, Function f)
+        {
+            assert(GridCoordinate<Key>()(distance) <= _cell_size && "ECSA ERROR: distance greater than the cell size!");
+            Key squared = distance * distance;
+            for (int r = 0; r < Rows; r++)
+            {
+                for (int c = 0; c < Columns; c++)
+                {
+                    int cell = r * Columns + c;
+                    for (int i = _starts[cell]; i < _starts[cell + 1]; i++)
+                    {
+                        // same cell, then the neighbours on the right and on the next row
+                        compare(i, i + 1, _starts[cell + 1], squared, f);
+                        if (c + 1 < Columns)
+                            compare(i, _starts[cell + 1], _starts[cell + 2], squared, f);
+                        if (r + 1 < Rows)
+                        {
+                            int below = cell + Columns;
+                            int first = _starts[c > 0 ? below - 1 : below];
+                            int last = _starts[c + 1 < Columns ? below + 2 : below + 1];
+                            compare(i, first, last, squared, f);
+                        }
+                    }
+                }
+            }
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
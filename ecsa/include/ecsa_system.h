@@ -5,9 +5,47 @@
 
 namespace ecsa
 {
-    template<int TableEntities, int SystemEntities>
-    class System : public ISystem
+    template<int... Ids>
+    struct All
     {
+        static constexpr int count = sizeof...(Ids);
+        static constexpr int ids [ sizeof...(Ids) + 1 ] = { Ids..., 0 };
+    };
+
+
+    template<int... Ids>
+    struct None
+    {
+        static constexpr int count = sizeof...(Ids);
+        static constexpr int ids [ sizeof...(Ids) + 1 ] = { Ids..., 0 };
+    };
+
+
+    template<int... Ids>
+    struct Reads
+    {
+        static constexpr int count = sizeof...(Ids);
+        static constexpr int ids [ sizeof...(Ids) + 1 ] = { Ids..., 0 };
+    };
+
+
+    template<int... Ids>
+    struct Writes
+    {
+        static constexpr int count = sizeof...(Ids);
+        static constexpr int ids [ sizeof...(Ids) + 1 ] = { Ids..., 0 };
+    };
+
+
+    template<int TableEntities, int SystemEntities, int... RequiredIds, int... ExcludedIds>
+    class System<TableEntities, SystemEntities, All<RequiredIds...>, None<ExcludedIds...>> : public ISystem
+    {
+        /**
+         * @brief The type the Ids of the subscribed entities are stored as.
+         * 
+         */
+        using Index = EntityIndex<TableEntities>;
+
 
         protected:
 
@@ -21,10 +59,51 @@ namespace ecsa
          * @brief An entity bag with the Ids of the subscribed entities.
          * 
          */
-        EntityBag<SystemEntities> _subscribed;
+        EntityBag<SystemEntities, Index> _subscribed;
+
+        /**
+         * @brief The index of each subscribed entity in `_subscribed`.
+         * Only meaningful for the entities in `_mask_subscribed`.
+         * 
+         */
+        Array<EntityIndex<SystemEntities>, TableEntities> _slots;
 
         public:
 
+        /**
+         * @brief Constructor.
+         * 
+         */
+        System()
+        {
+            _required = All<RequiredIds...>::ids;
+            _required_count = All<RequiredIds...>::count;
+            _excluded = None<ExcludedIds...>::ids;
+            _excluded_count = None<ExcludedIds...>::count;
+            _table_entities = TableEntities;
+        }
+
+
+        /**
+         * @brief Declare the components the system reads and writes in `update` (usually in the constructor).
+         * A table with an `Executor` runs the systems that do not conflict (no component written by one of them
+         * and read or written by the other) at the same time, and keeps the order of the Ids for the others.
+         * Systems that do not declare their components conflict with every other system.
+         * 
+         * @tparam Read A `Reads` with the Ids of the components the system only reads.
+         * @tparam Write A `Writes` with the Ids of the components the system writes.
+         */
+        template<typename Read, typename Write = Writes<>>
+        void access()
+        {
+            _reads = Read::ids;
+            _reads_count = Read::count;
+            _writes = Write::ids;
+            _writes_count = Write::count;
+            _access = true;
+        }
+
+
         /**
          * @brief Subscribe an entity to the query.
          * 
@@ -32,6 +111,7 @@ namespace ecsa
          */
         void subscribe(Entity e) override
         {
+            _slots[e] = _subscribed.size();
             _subscribed.push_back(e);
             _mask_subscribed.add(e);
         }
@@ -39,23 +119,63 @@ namespace ecsa
 
         /**
          * @brief Unsubscribe an entity from the query.
+         * The last subscribed entity is moved into the slot left free, so this takes constant time.
          * 
          * @param e The Id of the entity.
          */
         void unsubscribe(Entity e) override
         {
-            for (int i = 0; i < _subscribed.size(); i++)
+            if (!_mask_subscribed.contains(e))
+                return;
+            int i = _slots[e];
+            Entity last = _subscribed.back();
+            _subscribed.erase(i);
+            _slots[last] = i;
+            _mask_subscribed.destroy(e);
+        }
+
+
+        /**
+         * @brief Unsubscribe a batch of entities from the query.
+         * The remaining entities are compacted in a single pass, and keep their relative order.
+         * 
+         * @param mask The words of an `EntityMask<TableEntities>` of the entities.
+         */
+        void unsubscribe(const unsigned int * mask) override
+        {
+            Index * ids = _subscribed.begin();
+            int size = _subscribed.size();
+            int first = 0;
+            while (first < size && ((mask[ids[first] >> 5] >> (ids[first] & 31)) & 1) == 0)
+                first++;
+            if (first == size)
+                return;
+            _subscribed.clear();
+            for (int i = 0; i < size; i++)
             {
-                if (_subscribed[i] == e)
-                {
-                    _subscribed.erase(i);
+                Entity e = ids[i];
+                if (((mask[e >> 5] >> (e & 31)) & 1) != 0)
                     _mask_subscribed.destroy(e);
-                    break;
+                else
+                {
+                    _slots[e] = _subscribed.size();
+                    _subscribed.push_back(e);
                 }
             }
         }
 
 
+        /**
+         * @brief Unsubscribe all the entities from the query, without visiting them.
+         * 
+         */
+        void clear() override
+        {
+            _mask_subscribed.clear();
+            _subscribed.clear();
+        }
+
+
         /**
          * @brief Tells whether an entity is subscribed to the query or not.
          * 
@@ -70,13 +190,46 @@ namespace ecsa
 
         
         /**
-         * @brief Returns an entity bag with the Ids of the subscribed entities.
+         * @brief Returns a view over the Ids of the subscribed entities, without copying them.
+         * The view is valid until an entity is subscribed to the system or unsubscribed from it.
+         * 
+         * @return BasicEntityView<EntityIndex<TableEntities>> 
+         */
+        [[nodiscard]] BasicEntityView<Index> subscribed()
+        {
+            return BasicEntityView<Index>(_subscribed.begin(), _subscribed.size());
+        }
+
+
+        /**
+         * @brief Call a function on each subscribed entity, splitting them in chunks that the workers of the executor
+         * of the table process at the same time (or in order on the calling thread, if the table has no executor).
+         * The function must only access the data of its own entity, or the data of its worker (see `PerWorker`),
+         * and must not add or remove components. It can mark the components of its entity as changed (`get_mut`,
+         * `mark_changed`), except the ones with an index: re-indexing an entity is not safe from several workers.
          * 
-         * @return EntityBag<SystemEntities> 
+         * @tparam Function The type of the function: a function, lambda or functor taking `(Entity)` or `(Entity, int worker)`.
+         * @param chunk_size The number of entities in each chunk.
+         * @param f The function.
          */
-        [[nodiscard]] EntityBag<SystemEntities> subscribed()
+        template<typename Function>
+        void parallel_for_each(int chunk_size, Function f)
+        {
+            _chunking = _executor != nullptr;
+            ecsa::parallel_for_each(_executor, subscribed(), chunk_size, f);
+            _chunking = false;
+        }
+
+
+        [[nodiscard]] const void * subscribed_ids() override
+        {
+            return _subscribed.begin();
+        }
+
+
+        [[nodiscard]] int subscribed_count() override
         {
-            return _subscribed;
+            return _subscribed.size();
         }
 
         virtual ~System() = default;
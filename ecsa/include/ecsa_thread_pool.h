@@ -0,0 +1,222 @@
+#ifndef ECSA_THREAD_POOL_H
+#define ECSA_THREAD_POOL_H
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    /**
+     * @brief An executor running the tasks of a batch on a pool of worker threads and on the calling thread.
+     * Idle workers take the next task of the batch as soon as they finish one, so the load is balanced
+     * even when the tasks take different times.
+     * Only for platforms with threads: this header is not included by `ecsa.h`.
+     * 
+     */
+    class ThreadPool : public Executor
+    {
+        /**
+         * @brief The worker threads (the calling thread is worker 0, and does not belong to the pool).
+         * 
+         */
+        std::thread * _threads;
+        int _thread_count;
+
+
+        /**
+         * @brief The current batch.
+         * 
+         */
+        Task _task;
+        void * _context;
+        int _count;
+
+
+        /**
+         * @brief The next task of the current batch to run.
+         * 
+         */
+        std::atomic<int> _next;
+
+
+        /**
+         * @brief Counts the batches, so that the workers can tell when a new one starts.
+         * 
+         */
+        unsigned int _batch;
+
+
+        /**
+         * @brief The number of workers that have not finished the current batch yet.
+         * 
+         */
+        int _busy;
+
+
+        /**
+         * @brief Tells if the workers must stop.
+         * 
+         */
+        bool _stop;
+
+
+        /**
+         * @brief Tells if the tasks are run on the calling thread only, in order.
+         * 
+         */
+        bool _deterministic;
+
+
+        /**
+         * @brief Tells if a batch is running. A batch started by one of its own tasks (for example, a `parallel_for_each`
+         * in a system updated at the same time as other systems) runs on the thread of that task.
+         * 
+         */
+        std::atomic<bool> _active;
+
+
+        /**
+         * @brief The index of the worker running on the current thread (0 for the threads outside the pool).
+         * 
+         */
+        inline static thread_local int _worker = 0;
+
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _done;
+
+
+        /**
+         * @brief Run the tasks of the current batch until there are none left.
+         * 
+         * @param worker The index of the worker.
+         */
+        void work(int worker)
+        {
+            for (int i = _next.fetch_add(1); i < _count; i = _next.fetch_add(1))
+                _task(_context, i, worker);
+        }
+
+
+        /**
+         * @brief The loop of a worker thread: wait for a batch, run its tasks, and tell the calling thread when done.
+         * 
+         * @param worker The index of the worker.
+         */
+        void loop(int worker)
+        {
+            _worker = worker;
+            unsigned int seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wake.wait(lock, [this, seen]() { return _stop || _batch != seen; });
+                    if (_stop)
+                        return;
+                    seen = _batch;
+                }
+                work(worker);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (--_busy == 0)
+                        _done.notify_one();
+                }
+            }
+        }
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         * @param threads The number of worker threads, besides the calling thread (0 runs everything on the calling thread).
+         */
+        ThreadPool(int threads) : _threads(nullptr), _thread_count(threads), _task(nullptr), _context(nullptr), _count(0),
+            _next(0), _batch(0), _busy(0), _stop(false), _deterministic(false), _active(false)
+        {
+            assert(threads >= 0 && "ECSA ERROR: invalid number of threads!");
+            if (threads > 0)
+                _threads = new std::thread [ threads ];
+            for (int i = 0; i < threads; i++)
+                _threads[i] = std::thread([this, i]() { loop(i + 1); });
+        }
+
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+
+        /**
+         * @brief Run every task on the calling thread, in order, as worker 0 (or go back to using the worker threads).
+         * Useful to debug: the systems and entities are then processed in a reproducible order.
+         * 
+         * @param deterministic Tells if the tasks are run on the calling thread only.
+         */
+        void deterministic(bool deterministic)
+        {
+            _deterministic = deterministic;
+        }
+
+
+        [[nodiscard]] int workers() override
+        {
+            return _deterministic ? 1 : _thread_count + 1;
+        }
+
+
+        void run(Task task, void * context, int count) override
+        {
+            if (_deterministic || _thread_count == 0 || count == 1 || _active.exchange(true))
+            {
+                for (int i = 0; i < count; i++)
+                    task(context, i, _worker);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task = task;
+                _context = context;
+                _count = count;
+                _next.store(0);
+                _busy = _thread_count;
+                _batch++;
+            }
+            _wake.notify_all();
+            work(0);
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this]() { return _busy == 0; });
+            _active.store(false);
+        }
+
+
+        /**
+         * @brief Destructor. Stops and joins the worker threads.
+         * 
+         */
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wake.notify_all();
+            for (int i = 0; i < _thread_count; i++)
+                _threads[i].join();
+            delete [] _threads;
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
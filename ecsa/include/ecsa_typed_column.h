@@ -0,0 +1,133 @@
+#ifndef ECSA_TYPED_COLUMN_H
+#define ECSA_TYPED_COLUMN_H
+
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ecsa.h"
+
+
+namespace ecsa
+{
+    template<typename Type, int Entities>
+    class TypedColumn
+    {
+        /**
+         * @brief Storage for the components, indexed by entity Id.
+         * Components are constructed in place, only for the entities that own them.
+         * 
+         */
+        alignas(Type) unsigned char _data [ sizeof(Type) * (Entities == 0 ? 1 : Entities) ];
+
+
+        /**
+         * @brief A mask tracking which entities own a component.
+         * 
+         */
+        EntityMask<Entities> _mask;
+
+
+        public:
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        TypedColumn()
+        {
+
+        }
+
+
+        TypedColumn(const TypedColumn &) = delete;
+        TypedColumn & operator=(const TypedColumn &) = delete;
+
+
+        /**
+         * @brief Tells if an entity owns a component in the column.
+         * 
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains(Entity e)
+        {
+            return _mask.contains(e);
+        }
+
+
+        /**
+         * @brief Construct the component of an entity in place.
+         * 
+         * @tparam Args The types of the arguments passed to the component's constructor.
+         * @param e The Id of the entity.
+         * @param args The arguments passed to the component's constructor.
+         * @return Type&
+         */
+        template<typename... Args>
+        Type & emplace(Entity e, Args &&... args)
+        {
+            assert(!contains(e) && "ECSA ERROR: component already exists!");
+            _mask.add(e);
+            return *(new (_data + e * sizeof(Type)) Type(std::forward<Args>(args)...));
+        }
+
+
+        /**
+         * @brief Destroy the component of an entity (if present).
+         * Nothing is done for trivially destructible components apart from clearing the mask.
+         * 
+         * @param e The Id of the entity.
+         */
+        void erase(Entity e)
+        {
+            if (!contains(e))
+                return;
+            if constexpr (!std::is_trivially_destructible_v<Type>)
+                (*this)[e].~Type();
+            _mask.destroy(e);
+        }
+
+
+        /**
+         * @brief Destroy all the components in the column.
+         * 
+         */
+        void clear()
+        {
+            if constexpr (!std::is_trivially_destructible_v<Type>)
+                _mask.for_each([this](Entity e) { (*this)[e].~Type(); });
+            _mask.clear();
+        }
+
+
+        /**
+         * @brief Returns a reference to the component of an entity.
+         * 
+         * @param e The Id of the entity.
+         * @return Type&
+         */
+        [[nodiscard]] Type & operator[](Entity e)
+        {
+            assert(contains(e) && "ECSA ERROR: component not found!");
+            return *((Type *) (_data + e * sizeof(Type)));
+        }
+
+
+        /**
+         * @brief Destructor.
+         * 
+         */
+        ~TypedColumn()
+        {
+            clear();
+        }
+
+    };
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,302 @@
+#ifndef ECSA_TYPED_ENTITY_TABLE_H
+#define ECSA_TYPED_ENTITY_TABLE_H
+
+#include <cassert>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ecsa.h"
+
+namespace ecsa
+{
+    template<typename... Types>
+    struct ComponentList
+    {
+        /**
+         * @brief The number of components in the list.
+         * 
+         */
+        static constexpr int size = sizeof...(Types);
+
+
+        /**
+         * @brief The type of the component with a certain Id (its index in the list).
+         * 
+         */
+        template<int Id>
+        using type = typename std::tuple_element<Id, std::tuple<Types...>>::type;
+    };
+
+
+    template<int Entities, typename... Types, int Systems>
+    class TypedEntityTable<Entities, ComponentList<Types...>, Systems>
+        : public BasicTable<TypedEntityTable<Entities, ComponentList<Types...>, Systems>, Entities, sizeof...(Types), Systems>
+    {
+        using Base = BasicTable<TypedEntityTable<Entities, ComponentList<Types...>, Systems>, Entities, sizeof...(Types), Systems>;
+
+        template<int Id>
+        using Type = typename ComponentList<Types...>::template type<Id>;
+
+        EntityMask<Entities> _entities;
+        Array<Signature<sizeof...(Types)>, Entities> _signatures;
+        std::tuple<TypedColumn<Types, Entities>...> _columns;
+
+        public:
+
+        using Base::add;
+        using Base::get;
+
+
+        /**
+         * @brief Constructor.
+         * 
+         */
+        TypedEntityTable()
+        {
+
+        }
+
+
+        /**
+         * @brief Create a new entity and return its Id.
+         * 
+         * @return Entity
+         */
+        [[nodiscard]] Entity create()
+        {
+            return _entities.create();
+        }
+
+
+        /**
+         * @brief Create a number of new entities, with contiguous Ids if possible.
+         * If the table is full, the bag only holds the entities that could be created.
+         * 
+         * @tparam Size The maximum size of the returned entity bag.
+         * @param n The number of entities.
+         * @return EntityBag<Size, EntityIndex<Entities>> The Ids of the new entities.
+         */
+        template<int Size>
+        [[nodiscard]] EntityBag<Size, EntityIndex<Entities>> create(int n)
+        {
+            EntityBag<Size, EntityIndex<Entities>> entities;
+            _entities.create(n, entities);
+            return entities;
+        }
+
+
+        /**
+         * @brief Remove an entity from the table,
+         * and unsubscribe it from all the relevant systems.
+         * 
+         * @param e The Id of the entity.
+         */
+        void destroy(Entity e)
+        {
+            std::apply([e](auto &... columns) { (columns.erase(e), ...); }, _columns);
+            this->retire(e);
+            _signatures[e].clear();
+            _entities.destroy(e);
+        }
+
+
+        /**
+         * @brief Destroy all the entities in the table.
+         * The components are destroyed one column at a time, and the systems drop all their entities at once.
+         * 
+         */
+        void clear()
+        {
+            this->reset(_entities);
+            std::apply([](auto &... columns) { (columns.clear(), ...); }, _columns);
+            _entities.for_each([this](Entity e) { _signatures[e].clear(); });
+            _entities.clear();
+        }
+
+
+        /**
+         * @brief Tells if the table contains a certain entity.
+         * 
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        [[nodiscard]] bool contains(Entity e)
+        {
+            return _entities.contains(e);
+        }
+
+
+        /**
+         * @brief Returns the mask of the entities in the table, which can be iterated
+         * to visit them in increasing order without checking the empty slots.
+         * 
+         * @return const EntityMask<Entities>& 
+         */
+        [[nodiscard]] const EntityMask<Entities> & entities()
+        {
+            return _entities;
+        }
+
+
+        /**
+         * @brief Construct a component of an entity in place.
+         * 
+         * @tparam Id The Id of the component.
+         * @tparam Args The types of the arguments passed to the component's constructor.
+         * @param e The Id of the entity.
+         * @param args The arguments passed to the component's constructor.
+         * @return Type<Id>&
+         */
+        template<int Id, typename... Args>
+        Type<Id> & emplace(Entity e, Args &&... args)
+        {
+            Type<Id> & c = std::get<Id>(_columns).emplace(e, std::forward<Args>(args)...);
+            _signatures[e].add(Id);
+            this->refresh(e, Id);
+            return c;
+        }
+
+
+        /**
+         * @brief Construct a component of an entity in place.
+         * Same as `emplace<Id>`, but also checks at compile time that `ComponentType` is the type of the column.
+         * 
+         * @tparam ComponentType The type of the component.
+         * @tparam Id The Id of the component.
+         * @tparam Args The types of the arguments passed to the component's constructor.
+         * @param e The Id of the entity.
+         * @param args The arguments passed to the component's constructor.
+         * @return ComponentType&
+         */
+        template<typename ComponentType, int Id, typename... Args>
+        ComponentType & emplace(Entity e, Args &&... args)
+        {
+            static_assert(std::is_same_v<ComponentType, Type<Id>>, "ECSA ERROR: wrong component type!");
+            return emplace<Id>(e, std::forward<Args>(args)...);
+        }
+
+
+        /**
+         * @brief Add a component to an entity. (will be copied)
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @param c The component.
+         */
+        template<int Id>
+        void add(Entity e, const Type<Id> & c)
+        {
+            emplace<Id>(e, c);
+        }
+
+
+        /**
+         * @brief Add a component to an entity. (will be copied)
+         * Same as `add<Id>`, but also checks at compile time that `ComponentType` is the type of the column.
+         * 
+         * @tparam ComponentType The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @param c The component.
+         */
+        template<typename ComponentType, int Id>
+        void add(Entity e, const ComponentType & c)
+        {
+            emplace<ComponentType, Id>(e, c);
+        }
+
+
+        /**
+         * @brief Remove a component from an entity, and update its subscriptions to the systems that depend on it.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         */
+        template<int Id>
+        void remove(Entity e)
+        {
+            assert(has<Id>(e) && "ECSA ERROR: component not found!");
+            std::get<Id>(_columns).erase(e);
+            _signatures[e].destroy(Id);
+            this->refresh(e, Id);
+        }
+
+
+        /**
+         * @brief Get a reference to the component of an entity.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return Type<Id>&
+         */
+        template<int Id>
+        [[nodiscard]] Type<Id> & get(Entity e)
+        {
+            return std::get<Id>(_columns)[e];
+        }
+
+
+        /**
+         * @brief Get a reference to the component of an entity.
+         * Same as `get<Id>`, but also checks at compile time that `ComponentType` is the type of the column.
+         * 
+         * @tparam ComponentType The type of the component.
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return ComponentType&
+         */
+        template<typename ComponentType, int Id>
+        [[nodiscard]] ComponentType & get(Entity e)
+        {
+            static_assert(std::is_same_v<ComponentType, Type<Id>>, "ECSA ERROR: wrong component type!");
+            return std::get<Id>(_columns)[e];
+        }
+
+
+        /**
+         * @brief Returns a reference to the column storing the components with a certain Id.
+         * 
+         * @tparam ComponentType The type of the component.
+         * @tparam Id The Id of the component.
+         * @return TypedColumn<ComponentType, Entities>&
+         */
+        template<typename ComponentType, int Id>
+        [[nodiscard]] TypedColumn<ComponentType, Entities> & get()
+        {
+            static_assert(std::is_same_v<ComponentType, Type<Id>>, "ECSA ERROR: wrong component type!");
+            return std::get<Id>(_columns);
+        }
+
+
+        /**
+         * @brief Tells if an entity has a certain component.
+         * 
+         * @tparam Id The Id of the component.
+         * @param e The Id of the entity.
+         * @return true
+         * @return false
+         */
+        template<int Id>
+        [[nodiscard]] bool has(Entity e)
+        {
+            return _signatures[e].contains(Id);
+        }
+
+
+        /**
+         * @brief Returns the signature of an entity (the set of components it owns).
+         * 
+         * @param e The Id of the entity.
+         * @return Signature<sizeof...(Types)>& 
+         */
+        [[nodiscard]] Signature<sizeof...(Types)> & signature(Entity e)
+        {
+            return _signatures[e];
+        }
+
+    };
+}
+
+#endif
\ No newline at end of file
@@ -155,7 +155,7 @@ int main()
         // towards the right, and reverse their x direction
         if (bn::keypad::a_pressed())
         {
-            EntityBag<2> ids = table.query<2>(&find_entities_moving_right);
+            Table::Bag<2> ids = table.query<2>(&find_entities_moving_right);
             for (Entity e : ids)
             {
                 Vector2 & vel = table.get<Vector2, VELOCITY>(e);
@@ -12,11 +12,21 @@ namespace cs
     // parametrization of an entity table and its updaters
     using Entity = ecsa::Entity;
     using Component = ecsa::Component;
-    using Table  = ecsa::EntityTable<128, 8, 6>;
-    template<int TableEntities, int SystemEntities>
-    using System = ecsa::System<TableEntities, SystemEntities>;
+    using Table  = ecsa::EntityTable<128, 8, 7>;
+    template<int TableEntities, int SystemEntities, typename... Filters>
+    using System = ecsa::System<TableEntities, SystemEntities, Filters...>;
+    template<int TableEntities, int Size, typename... Filters>
+    using CachedQuery = ecsa::CachedQuery<TableEntities, Size, Filters...>;
+    template<int... Ids>
+    using All = ecsa::All<Ids...>;
+    template<int... Ids>
+    using None = ecsa::None<Ids...>;
     template<int MaxSize>
-    using EntityBag = ecsa::EntityBag<MaxSize>;
+    using EntityBag = Table::Bag<MaxSize>;
+    template<typename... Components>
+    using Prefab = ecsa::Prefab<Table, Components...>;
+    template<typename Type, int Id>
+    using With = ecsa::With<Type, Id>;
 
     // colors
     enum class Colors
@@ -39,6 +49,11 @@ namespace cs
     {
         bn::optional<bn::sprite_ptr> sprite;
 
+        Gfx()
+        {
+
+        }
+
         Gfx(bn::sprite_ptr sprite): sprite(sprite)
         {
 
@@ -100,7 +115,10 @@ namespace cs
             SYSSCALING = 2,
             SYSVISIBILITY = 3,
             SYSENTITYMANAGER = 4,
-            SYSANIMATION = 5
+            SYSANIMATION = 5,
+
+            // cached queries
+            QRYREDSQUARES = 6
         };
     }
     
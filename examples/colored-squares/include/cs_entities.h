@@ -5,16 +5,37 @@
 
 
 /**
- * @brief This namespace contains functions that generate entities
+ * @brief This namespace contains the prefabs that generate entities
  * of different type.
  * 
  */
 namespace cs::entities
 {
-    void red_square(Table& table);
-    void blue_square(Table& table);
-    void yellow_square(Table& table);
-    void flashing_square(Table& table);
+    using RedSquare = Prefab<With<Vector2, Ids::POSITION>, With<Vector2, Ids::VELOCITY>, With<Color, Ids::COLOR>, With<Gfx, Ids::GFX>>;
+    using BlueSquare = Prefab<With<Vector2, Ids::POSITION>, With<Vector2, Ids::VELOCITY>, With<Color, Ids::COLOR>, With<Transform, Ids::TRANSFORM>, With<Gfx, Ids::GFX>>;
+    using YellowSquare = BlueSquare;
+    using FlashingSquare = Prefab<With<Vector2, Ids::POSITION>, With<Vector2, Ids::VELOCITY>, With<Color, Ids::COLOR>, With<Animation, Ids::ANIMATION>, With<Gfx, Ids::GFX>>;
+
+    /**
+     * @brief The prefabs of the squares, created once with the table
+     * and reused for every new square.
+     * 
+     */
+    class Squares
+    {
+        RedSquare red;
+        BlueSquare blue;
+        YellowSquare yellow;
+        FlashingSquare flashing;
+
+        public:
+
+        Squares(Table& table);
+        void red_square();
+        void blue_square();
+        void yellow_square();
+        void flashing_square();
+    };
 }
 
 #endif
\ No newline at end of file
@@ -10,13 +10,19 @@
  */
 namespace cs::queries
 {
-    bool find_red_squares(Table& table, Entity e);
-
-    struct XBoundary
+    // cached query: the table keeps its results up to date
+    class RedSquares : public CachedQuery<128, 96, All<Ids::COLOR>>
     {
-        bn::fixed min, max;
+        Table& table;
+
+        public:
+
+        RedSquares(Table& t);
+        bool select(Entity e) override;
     };
-    bool find_yellow_squares_within(Table& table, Entity e, XBoundary& b);
+
+    // index on the color of the squares: the table keeps it up to date
+    using ColorIndex = ecsa::HashIndex<Table, Color, Ids::COLOR, &Color::color, 4>;
     
 }
 
@@ -10,14 +10,13 @@ namespace cs
      * the animation for entities with an ANIMATION component.
      * 
      */
-    class SysAnimation : public System<128, 64>
+    class SysAnimation : public System<128, 64, All<Ids::ANIMATION>>
     {
         Table & table;
 
         public:
 
         SysAnimation(Table& t);
-        bool select(Entity e) override;
         void init() override;
         void update() override;
     };
@@ -2,6 +2,8 @@
 #define CS_SYS_ENTITY_MANAGER_H
 
 #include "cs_definitions.h"
+#include "cs_entities.h"
+#include "cs_queries.h"
 
 namespace cs
 {
@@ -13,10 +15,12 @@ namespace cs
     class SysEntityManager : public System<128, 0>
     {
         Table& table;
+        queries::ColorIndex* colors;
+        entities::Squares* squares;
         
         public:
 
-        SysEntityManager(Table& t);
+        SysEntityManager(Table& t, queries::ColorIndex* c, entities::Squares* s);
         void init() override;
         void update() override;
     };
@@ -10,14 +10,13 @@ namespace cs
      * of entities on screen.
      * 
      */
-    class SysMovement : public System<128, 128>
+    class SysMovement : public System<128, 128, All<Ids::POSITION, Ids::VELOCITY>>
     {
         Table& table;
 
         public:
 
         SysMovement(Table& t);
-        bool select(Entity e) override;
         void init() override;
         void update() override;
     };
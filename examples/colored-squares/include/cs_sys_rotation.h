@@ -10,14 +10,13 @@ namespace cs
      * sprite rotation for entity with a TRANSFORM component.
      * 
      */
-    class SysRotation : public System<128, 96>
+    class SysRotation : public System<128, 96, All<Ids::TRANSFORM>>
     {
         Table & table;
         
         public:
 
         SysRotation(Table& t);
-        bool select(Entity e) override;
         void init() override;
         void update() override;
     };
@@ -10,14 +10,13 @@ namespace cs
      * of the sprites of entities with the TRANSFORM component.
      * 
      */
-    class SysScaling : public System<128, 64>
+    class SysScaling : public System<128, 64, All<Ids::TRANSFORM>>
     {
         Table& table;
         
         public:
 
         SysScaling(Table& t);
-        bool select(Entity e) override;
         void init() override;
         void update() override;
     };
@@ -10,14 +10,13 @@ namespace cs
      * the visibility of all entities with a GFX component.
      * 
      */
-    class SysVisibility : public System<128, 32>
+    class SysVisibility : public System<128, 32, All<Ids::GFX>>
     {
         Table& table;
 
         public:
 
         SysVisibility(Table& t);
-        bool select(Entity e) override;
         void init() override;
         void update() override;
     };
@@ -3,49 +3,44 @@
 #include "bn_sprite_items_squares.h"
 
 
-void cs::entities::red_square(Table& table)
+namespace
 {
-    Entity e = table.create();
-    table.add<Ids::POSITION>(e, new Vector2(0, 0));
-    table.add<Ids::VELOCITY>(e, new Vector2(0.5, 0.5));
-    table.add<Ids::COLOR>(e, new Color(Colors::RED));
-    table.add<Ids::GFX>(e, new Gfx(bn::sprite_items::squares.create_sprite(0, 0)));
-    table.subscribe(e);
+    // gives each new square its own sprite, showing a certain tile
+    auto sprite(int tile)
+    {
+        return [tile](cs::Table& table, cs::Entity e) {
+            bn::sprite_ptr sprite = bn::sprite_items::squares.create_sprite(0, 0);
+            sprite.set_tiles(bn::sprite_items::squares.tiles_item(), tile);
+            table.get<cs::Gfx, cs::Ids::GFX>(e).sprite = sprite;
+        };
+    }
 }
 
-void cs::entities::blue_square(Table& table)
+cs::entities::Squares::Squares(Table& table) :
+    red(table, Vector2(0, 0), Vector2(0.5, 0.5), Color(Colors::RED), Gfx()),
+    blue(table, Vector2(0, 0), Vector2(-0.5, 0.5), Color(Colors::BLUE), Transform(0, 1), Gfx()),
+    yellow(table, Vector2(0, 0), Vector2(-0.5, -0.5), Color(Colors::YELLOW), Transform(0, 1), Gfx()),
+    flashing(table, Vector2(0, 0), Vector2(0.5, -0.5), Color(Colors::FLASHING), Animation(0, 2), Gfx())
 {
-    Entity e = table.create();
-    table.add<Ids::POSITION>(e, new Vector2(0, 0));
-    table.add<Ids::VELOCITY>(e, new Vector2(-0.5, 0.5));
-    table.add<Ids::COLOR>(e, new Color(Colors::BLUE));
-    table.add<Ids::TRANSFORM>(e, new Transform(0, 1));
-    table.add<Ids::GFX>(e, new Gfx(bn::sprite_items::squares.create_sprite(0, 0)));
-    table.subscribe(e);
-
-    table.get<Gfx, Ids::GFX>(e).sprite.value().set_tiles(bn::sprite_items::squares.tiles_item(), 1);
+
+}
+
+void cs::entities::Squares::red_square()
+{
+    red.instantiate(sprite(0));
+}
+
+void cs::entities::Squares::blue_square()
+{
+    blue.instantiate(sprite(1));
 }
 
-void cs::entities::yellow_square(Table& table)
+void cs::entities::Squares::yellow_square()
 {
-    Entity e = table.create();
-    table.add<Ids::POSITION>(e, new Vector2(0, 0));
-    table.add<Ids::VELOCITY>(e, new Vector2(-0.5, -0.5));
-    table.add<Ids::COLOR>(e, new Color(Colors::YELLOW));
-    table.add<Ids::TRANSFORM>(e, new Transform(0, 1));
-    table.add<Ids::GFX>(e, new Gfx(bn::sprite_items::squares.create_sprite(0, 0)));
-    table.subscribe(e);
-
-    table.get<Gfx, Ids::GFX>(e).sprite.value().set_tiles(bn::sprite_items::squares.tiles_item(), 2);
+    yellow.instantiate(sprite(2));
 }
 
-void cs::entities::flashing_square(Table& table)
+void cs::entities::Squares::flashing_square()
 {
-    Entity e = table.create();
-    table.add<Ids::POSITION>(e, new Vector2(0, 0));
-    table.add<Ids::VELOCITY>(e, new Vector2(0.5, -0.5));
-    table.add<Ids::COLOR>(e, new Color(Colors::FLASHING));
-    table.add<Ids::ANIMATION>(e, new Animation(0, 2));
-    table.add<Ids::GFX>(e, new Gfx(bn::sprite_items::squares.create_sprite(0, 0)));
-    table.subscribe(e);
+    flashing.instantiate(sprite(0));
 }
\ No newline at end of file
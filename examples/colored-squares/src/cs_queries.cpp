@@ -1,23 +1,16 @@
 #include "cs_queries.h"
 
 
-bool cs::queries::find_red_squares(Table& table, Entity e)
+cs::queries::RedSquares::RedSquares(Table& t) :
+    CachedQuery<128, 96, All<Ids::COLOR>>(),
+    table(t)
 {
-    Color & col = table.get<Color, Ids::COLOR>(e);
-    return col.color == Colors::RED;
+
 }
 
 
-bool cs::queries::find_yellow_squares_within(Table& table, Entity e, XBoundary& b)
+bool cs::queries::RedSquares::select(Entity e)
 {
-    if (!table.has<Ids::COLOR>(e))
-        return false;
-
     Color & col = table.get<Color, Ids::COLOR>(e);
-    Vector2 & pos = table.get<Vector2, Ids::POSITION>(e);
-
-    if (col.color == Colors::YELLOW && pos.x < b.max && pos.x > b.min)
-        return true;
-
-    return false;
+    return col.color == Colors::RED;
 }
\ No newline at end of file
@@ -4,17 +4,12 @@
 #include "bn_sprite_items_squares.h"
 
 cs::SysAnimation::SysAnimation(Table& t) :
-    System<128, 64>(),
+    System<128, 64, All<Ids::ANIMATION>>(),
     table(t)
 {
     
 }
 
-bool cs::SysAnimation::select(Entity e)
-{
-    return table.has<Ids::ANIMATION>(e);
-}
-
 void cs::SysAnimation::init()
 {
 
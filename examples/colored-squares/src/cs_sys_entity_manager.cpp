@@ -7,9 +7,11 @@
 
 #include "bn_log.h"
 
-cs::SysEntityManager::SysEntityManager(Table& t) :
+cs::SysEntityManager::SysEntityManager(Table& t, queries::ColorIndex* c, entities::Squares* s) :
     System<128, 0>(),
-    table(t)
+    table(t),
+    colors(c),
+    squares(s)
 {
     
 }
@@ -24,17 +26,16 @@ void cs::SysEntityManager::update()
     // generate four new squares
     if (bn::keypad::a_pressed())
     {
-        entities::red_square(table);
-        entities::blue_square(table);
-        entities::yellow_square(table);
-        entities::flashing_square(table);
+        squares->red_square();
+        squares->blue_square();
+        squares->yellow_square();
+        squares->flashing_square();
     }
     // delete all the red squares
     if (bn::keypad::up_pressed())
     {
-        EntityBag<96> ids = table.query<96>(&queries::find_red_squares);
-        for (Entity e : ids)
-            table.destroy(e);
+        for (Entity e : table.view<Ids::QRYREDSQUARES>()) // no scan: the results are cached
+            table.defer().destroy(e); // destroyed at the end of table.update()
     }
     // delete all the squares
     else if (bn::keypad::down_pressed())
@@ -44,18 +45,21 @@ void cs::SysEntityManager::update()
     // delete all the rotating squares
     else if (bn::keypad::left_pressed())
     {
-        EntityBag<96> ids = table.query<96, Ids::SYSROTATION>();
-        for (Entity e : ids)
-            table.destroy(e);
+        for (Entity e : table.view<Ids::SYSROTATION>())
+            table.defer().destroy(e);
     }
     // freeze all the yellow squares with -64 < x < 64
     else if (bn::keypad::right_pressed())
     {
-        // define the x boundary and run the query
-        queries::XBoundary b = { .min = -64, .max = 64 };
-        EntityBag<128> yellow_squares = table.query<128, queries::XBoundary>(&queries::find_yellow_squares_within, b);
+        // define the x boundary and build the query (nothing is evaluated yet)
+        bn::fixed min = -64, max = 64;
+        auto yellow_squares = table.from(colors->equal(Colors::YELLOW)) // only the yellow squares, from the index
+            .where([min, max](Table& t, Entity e) {
+                bn::fixed x = t.get<Vector2, Ids::POSITION>(e).x;
+                return x < max && x > min;
+            });
         
-        // stop movement for all entities returned by the query
+        // stop movement for all entities returned by the query (filters are run while iterating)
         for (Entity e : yellow_squares)
         {
             Vector2 & vel = table.get<Vector2, Ids::VELOCITY>(e);
@@ -1,18 +1,12 @@
 #include "cs_sys_movement.h"
 
 cs::SysMovement::SysMovement(Table& t) :
-    System<128, 128>(),
+    System<128, 128, All<Ids::POSITION, Ids::VELOCITY>>(),
     table(t)
 {
     
 }
 
-bool cs::SysMovement::select(Entity e)
-{
-    return table.has<Ids::POSITION>(e)
-        && table.has<Ids::VELOCITY>(e);
-}
-
 void cs::SysMovement::init()
 {
 
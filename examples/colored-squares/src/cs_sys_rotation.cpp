@@ -1,17 +1,12 @@
 #include "cs_sys_rotation.h"
 
 cs::SysRotation::SysRotation(Table& t) :
-    System<128, 96>(),
+    System<128, 96, All<Ids::TRANSFORM>>(),
     table(t)
 {
     
 }
 
-bool cs::SysRotation::select(Entity e)
-{
-    return table.has<Ids::TRANSFORM>(e);
-}
-
 void cs::SysRotation::init()
 {
 
@@ -4,17 +4,12 @@
 
 
 cs::SysScaling::SysScaling(Table& t) :
-    System<128, 64>(),
+    System<128, 64, All<Ids::TRANSFORM>>(),
     table(t)
 {
     
 }
 
-bool cs::SysScaling::select(Entity e)
-{
-    return table.has<Ids::TRANSFORM>(e);
-}
-
 void cs::SysScaling::init()
 {
 
@@ -22,21 +17,28 @@ void cs::SysScaling::init()
 
 void cs::SysScaling::update()
 {
-    for (Entity e : this->subscribed())
+    // toggle the scale (get_mut marks the transform as changed)
+    if (bn::keypad::r_pressed())
     {
-        Gfx & gfx = table.get<Gfx, Ids::GFX>(e);
-        Transform & transform = table.get<Transform, Ids::TRANSFORM>(e);
-
-        if (bn::keypad::r_pressed())
+        for (Entity e : this->subscribed())
         {
+            Transform & transform = table.get_mut<Transform, Ids::TRANSFORM>(e);
+
             if (transform.scale == 1)
                 transform.scale = 1.5;
             else
                 transform.scale = 1;
         }
+    }
+
+    // update the sprites only for the transforms added or changed since the last frame
+    // (SysRotation uses get, so the angle updates do not count as changes here)
+    for (Entity e : table.changed<Ids::TRANSFORM>())
+    {
+        Gfx & gfx = table.get<Gfx, Ids::GFX>(e);
+        Transform & transform = table.get<Transform, Ids::TRANSFORM>(e);
 
         if (gfx.sprite.has_value())
             gfx.sprite.value().set_scale(transform.scale);
     }
-        
 }
\ No newline at end of file
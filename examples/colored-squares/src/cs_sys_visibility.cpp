@@ -5,17 +5,12 @@
 
 
 cs::SysVisibility::SysVisibility(Table& t) :
-    System<128, 32>(),
+    System<128, 32, All<Ids::GFX>>(),
     table(t)
 {
     
 }
 
-bool cs::SysVisibility::select(Entity e)
-{
-    return table.has<Ids::GFX>(e);
-}
-
 void cs::SysVisibility::init()
 {
 
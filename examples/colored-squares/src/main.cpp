@@ -5,6 +5,7 @@
 
 #include "cs_entities.h"
 #include "cs_definitions.h"
+#include "cs_queries.h"
 
 #include "cs_sys_movement.h"
 #include "cs_sys_rotation.h"
@@ -30,16 +31,20 @@ int main()
     table.add<Ids::SYSVISIBILITY>(new SysVisibility(table));
     table.add<Ids::SYSSCALING>(new SysScaling(table));
     table.add<Ids::SYSANIMATION>(new SysAnimation(table));
-    table.add<Ids::SYSENTITYMANAGER>(new SysEntityManager(table));
+    queries::ColorIndex* colors = new queries::ColorIndex(table);
+    table.add(colors);
+    entities::Squares* squares = new entities::Squares(table); // the prefabs of the squares
+    table.add<Ids::SYSENTITYMANAGER>(new SysEntityManager(table, colors, squares));
+    table.add<Ids::QRYREDSQUARES>(new queries::RedSquares(table));
 
     // initialize all the updaters
     table.init();
 
     // add 4 entities
-    entities::red_square(table);
-    entities::blue_square(table);
-    entities::yellow_square(table);
-    entities::flashing_square(table);
+    squares->red_square();
+    squares->blue_square();
+    squares->yellow_square();
+    squares->flashing_square();
 
     while (true)
     {
@@ -0,0 +1,53 @@
+#include <cstdio>
+
+#include "ecsa.h"
+
+using namespace ecsa;
+
+// components
+struct Counter : Component
+{
+    int x = 0;
+};
+
+// create entities past the capacity of a table: the extra ones must fail with -1, without touching the others
+template<typename Table, int Entities>
+bool check(const char * name)
+{
+    Table * table = new Table();
+    bool ok = true;
+    for (int i = 0; i < Entities; i++)
+    {
+        if (table->create() != i)
+            ok = false;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+        if (table->create() != -1)
+            ok = false;
+    }
+    typename Table::template Bag<8> more = table->template create<8>(4);
+    if (!more.empty())
+        ok = false;
+    table->destroy(Entities / 2);
+    if (table->create() != Entities / 2 || table->create() != -1)
+        ok = false;
+    int count = 0;
+    for (Entity e : table->entities())
+        count += e >= 0 && e < Entities;
+    if (count != Entities)
+        ok = false;
+    delete table;
+    printf("%s: %s\n", name, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    ok &= check<EntityTable<96, 2, 1>, 96>("EntityTable<96>");
+    ok &= check<ArchetypeTable<96, 2, 1, 4>, 96>("ArchetypeTable<96>");
+    ok &= check<TypedEntityTable<96, ComponentList<Counter, Counter>, 1>, 96>("TypedEntityTable<96>");
+    ok &= check<ArchetypeTable<100, 2, 1, 4>, 100>("ArchetypeTable<100>");
+    return ok ? 0 : 1;
+}
\ No newline at end of file